@@ -0,0 +1,696 @@
+/**
+ * @file
+ *
+ * Micro-benchmarks for the linked list. Built without the sanitizer and with
+ * optimization (see the Makefile in this directory). Each benchmark prints one
+ * line with the processor time it took as measured by clock(), except for the
+ * multi-threaded ones, which report wall-clock time.
+ *
+ * With an element count argument only the traversal benchmark runs, at that
+ * size. Counts are size_t throughout, so sizes past UINT_MAX (10000000000 on a
+ * machine with enough memory) work the same as the defaults.
+ */
+// For clock_gettime
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "linked_list.h"
+#include "ll_pool.h"
+#include "skip_list.h"
+#include "tree_list.h"
+#include "unrolled_list.h"
+
+// Number of append/delete cycles in the churn benchmarks
+#define CHURN_CYCLES (1000000)
+
+// Number of nodes kept in the list during the churn benchmarks
+#define CHURN_DEPTH (1000)
+
+// Deterministic PRNG so that runs are comparable (xorshift64)
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static size_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return (size_t)rng_state;
+}
+
+static double seconds_since(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static double wall_seconds(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+static void report(const char *name, size_t n, double secs) {
+  printf("%-40s n=%-10zu %8.3f s %8.1f ns/op\n", name, n, secs,
+         secs * 1e9 / (double)n);
+}
+
+/**
+ * Queue-like churn: keep CHURN_DEPTH nodes in the list and append to the tail
+ * and delete from the head CHURN_CYCLES times.
+ */
+static void bench_churn(const char *name, const struct ll_allocator *alloc) {
+  struct ll_list list;
+  ll_list_init_with_allocator(&list, alloc);
+  for (size_t i = 0; i < CHURN_DEPTH; i++) {
+    ll_list_append(&list, NULL);
+  }
+
+  clock_t start = clock();
+  for (size_t i = 0; i < CHURN_CYCLES; i++) {
+    ll_list_append(&list, (void *)i);
+    ll_list_delete(&list, 0);
+  }
+  report(name, CHURN_CYCLES, seconds_since(start));
+
+  ll_list_destroy(&list);
+}
+
+/**
+ * Build an n-element list with an ll_list_append per element, with
+ * ll_list_append_array and with ll_append_array, and tear it down again.
+ */
+static void bench_build(size_t n) {
+  void **items = malloc(n * sizeof(void *));
+  struct ll_list list;
+  struct ll_node *head = NULL;
+  clock_t start;
+
+  if (items == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)i;
+  }
+
+  start = clock();
+  ll_list_init(&list);
+  for (size_t i = 0; i < n; i++) {
+    ll_list_append(&list, items[i]);
+  }
+  ll_list_destroy(&list);
+  report("build+destroy ll_list_append", n, seconds_since(start));
+
+  start = clock();
+  ll_list_from_array(&list, items, n);
+  ll_list_destroy(&list);
+  report("build+destroy ll_list_append_array", n, seconds_since(start));
+
+  start = clock();
+  ll_from_array(&head, items, n);
+  ll_destroy(&head);
+  report("build+destroy ll_append_array", n, seconds_since(start));
+
+  free(items);
+}
+
+static int is_odd(void *data, void *cookie) {
+  (void)cookie;
+  return (size_t)data % 2 == 1;
+}
+
+/**
+ * Build an n-element list from n / per calls of ll_list_append_array, so
+ * out of many small blocks, then delete half of it with ll_list_remove_if and
+ * destroy the rest.
+ */
+static void bench_small_blocks(size_t n, size_t per) {
+  void **items = malloc(per * sizeof(void *));
+  struct ll_list list;
+  char name[64];
+  clock_t start;
+
+  if (items == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < per; i++) {
+    items[i] = (void *)i;
+  }
+
+  ll_list_init(&list);
+  for (size_t i = 0; i < n / per; i++) {
+    ll_list_append_array(&list, items, per);
+  }
+  start = clock();
+  ll_list_remove_if(&list, is_odd, NULL, NULL);
+  snprintf(name, sizeof(name), "remove half, %zu-node blocks", per);
+  report(name, n, seconds_since(start));
+  start = clock();
+  ll_list_destroy(&list);
+  snprintf(name, sizeof(name), "destroy, %zu-node blocks", per);
+  report(name, n / 2, seconds_since(start));
+
+  free(items);
+}
+
+/**
+ * Relink the nodes of @p list in random order. Nodes of a list that has seen
+ * a lot of inserts and deletes end up scattered in memory like this, while a
+ * freshly appended list is laid out sequentially by malloc.
+ */
+static void scatter(struct ll_list *list) {
+  struct ll_node **nodes = malloc(list->length * sizeof(struct ll_node *));
+  size_t i = 0;
+  if (nodes == NULL) {
+    return;  // Leave the list in allocation order
+  }
+  for (struct ll_node *n = list->head; n != NULL; n = n->next) {
+    nodes[i++] = n;
+  }
+  for (i = list->length - 1; i > 0; i--) {
+    size_t j = rng() % (i + 1);
+    struct ll_node *t = nodes[i];
+    nodes[i] = nodes[j];
+    nodes[j] = t;
+  }
+  for (i = 0; i + 1 < list->length; i++) {
+    nodes[i]->next = nodes[i + 1];
+  }
+  nodes[list->length - 1]->next = NULL;
+  list->head = nodes[0];
+  list->tail = nodes[list->length - 1];
+  free(nodes);
+}
+
+static enum ll_status sum_node(struct ll_node *node, void *cookie) {
+  *(size_t *)cookie += (size_t)node->data;
+  return LL_OK;
+}
+
+static enum ll_status sum_data(void *data, void *cookie) {
+  *(size_t *)cookie += (size_t)data;
+  return LL_OK;
+}
+
+/**
+ * Build @p list from @p items with its nodes scattered in memory like in a
+ * long-lived list, but in the order of @p items.
+ */
+static void list_scattered(struct ll_list *list, void **items, size_t n) {
+  ll_list_from_array(list, items, n);
+  scatter(list);
+  size_t i = 0;
+  for (struct ll_node *node = list->head; node != NULL; node = node->next) {
+    node->data = items[i++];
+  }
+}
+
+static int cmp_key(void *a, void *b, void *cookie) {
+  (void)cookie;
+  return ((size_t)a > (size_t)b) - ((size_t)a < (size_t)b);
+}
+
+static int qsort_cmp_key(const void *a, const void *b) {
+  return cmp_key(*(void *const *)a, *(void *const *)b, NULL);
+}
+
+/**
+ * Sort an n-element list in place with ll_list_sort, and by copying it to an
+ * array, sorting that with qsort and building a new list from it.
+ */
+static void bench_sort_order(const char *order, void **items, size_t n) {
+  struct ll_list list;
+  void **sorted;
+  char name[64];
+  clock_t start;
+
+  list_scattered(&list, items, n);
+  start = clock();
+  ll_list_sort(&list, cmp_key, NULL);
+  snprintf(name, sizeof(name), "sort %s, ll_list_sort", order);
+  report(name, n, seconds_since(start));
+  ll_list_destroy(&list);
+
+  list_scattered(&list, items, n);
+  start = clock();
+  ll_list_to_array_alloc(&list, &sorted);
+  qsort(sorted, n, sizeof(void *), qsort_cmp_key);
+  ll_list_destroy(&list);
+  ll_list_init(&list);
+  for (size_t i = 0; i < n; i++) {
+    ll_list_append(&list, sorted[i]);
+  }
+  free(sorted);
+  snprintf(name, sizeof(name), "sort %s, copy+qsort+rebuild", order);
+  report(name, n, seconds_since(start));
+  ll_list_destroy(&list);
+}
+
+static void bench_sort(size_t n) {
+  void **items = malloc(n * sizeof(void *));
+  if (items == NULL) {
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)rng();
+  }
+  bench_sort_order("random", items, n);
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)i;
+  }
+  bench_sort_order("sorted", items, n);
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)(n - i);
+  }
+  bench_sort_order("reverse", items, n);
+
+  free(items);
+}
+
+static uint64_t key_of(void *data, void *cookie) {
+  (void)cookie;
+  return (uint64_t)(size_t)data;
+}
+
+/**
+ * Sort an n-element list of random keys of @p bits bits with ll_list_sort
+ * and with ll_list_radix_sort.
+ */
+static void bench_radix_sort(size_t n, unsigned int bits) {
+  void **items = malloc(n * sizeof(void *));
+  struct ll_list list;
+  char name[64];
+  clock_t start;
+
+  if (items == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)(bits < 64 ? rng() & ((1ULL << bits) - 1) : rng());
+  }
+
+  list_scattered(&list, items, n);
+  start = clock();
+  ll_list_sort(&list, cmp_key, NULL);
+  snprintf(name, sizeof(name), "sort %u-bit keys, ll_list_sort", bits);
+  report(name, n, seconds_since(start));
+  ll_list_destroy(&list);
+
+  list_scattered(&list, items, n);
+  start = clock();
+  ll_list_radix_sort(&list, key_of, NULL);
+  snprintf(name, sizeof(name), "sort %u-bit keys, ll_list_radix_sort", bits);
+  report(name, n, seconds_since(start));
+  ll_list_destroy(&list);
+
+  free(items);
+}
+
+/**
+ * Merge k sorted lists of random keys, n elements in total, with
+ * ll_list_merge_k, against concatenating them and sorting the result with
+ * ll_list_sort.
+ */
+static void bench_merge_k(size_t n, size_t k) {
+  void **items = malloc(n * sizeof(void *));
+  struct ll_list *lists = malloc(k * sizeof(struct ll_list));
+  char name[64];
+  clock_t start;
+
+  if (items == NULL || lists == NULL) {
+    free(items);
+    free(lists);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)rng();
+  }
+  for (size_t l = 0; l < k; l++) {
+    size_t from = n / k * l;
+    size_t to = l == k - 1 ? n : n / k * (l + 1);
+    qsort(items + from, to - from, sizeof(void *), qsort_cmp_key);
+  }
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (size_t l = 0; l < k; l++) {
+      size_t from = n / k * l;
+      size_t to = l == k - 1 ? n : n / k * (l + 1);
+      ll_list_from_array(&lists[l], items + from, to - from);
+    }
+    start = clock();
+    if (pass == 0) {
+      ll_list_merge_k(lists, k, cmp_key, NULL);
+      snprintf(name, sizeof(name), "merge %zu lists, ll_list_merge_k", k);
+    } else {
+      for (size_t l = 1; l < k; l++) {
+        ll_list_concat(&lists[0], &lists[l]);
+      }
+      ll_list_sort(&lists[0], cmp_key, NULL);
+      snprintf(name, sizeof(name), "merge %zu lists, concat + sort", k);
+    }
+    report(name, n, seconds_since(start));
+    for (size_t l = 0; l < k; l++) {
+      ll_list_destroy(&lists[l]);
+    }
+  }
+
+  free(lists);
+  free(items);
+}
+
+/**
+ * Delete every other element of an n-element list with ll_delete per match,
+ * which rewalks from the head each time, and with ll_remove_if.
+ */
+static void bench_remove_if(size_t n) {
+  struct ll_node *head = NULL;
+  clock_t start;
+
+  for (size_t i = n; i-- > 0;) {
+    ll_prepend(&head, (void *)i);
+  }
+  start = clock();
+  for (size_t i = 0; i < n / 2; i++) {
+    ll_delete_sz(&head, i + 1);
+  }
+  report("remove every other, ll_delete", n, seconds_since(start));
+  ll_destroy(&head);
+
+  for (size_t i = n; i-- > 0;) {
+    ll_prepend(&head, (void *)i);
+  }
+  start = clock();
+  ll_remove_if(&head, is_odd, NULL, NULL);
+  report("remove every other, ll_remove_if", n, seconds_since(start));
+  ll_destroy(&head);
+}
+
+/**
+ * Insert m elements at random positions of an n-element list, one
+ * ll_list_insert_after at a time and as one ll_list_insert_batch.
+ */
+static void bench_insert_batch(size_t n, size_t m) {
+  struct ll_insert_op *ops = malloc(m * sizeof(struct ll_insert_op));
+  void **items = malloc(n * sizeof(void *));
+  struct ll_list list;
+  clock_t start;
+
+  if (ops == NULL || items == NULL) {
+    free(ops);
+    free(items);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)i;
+  }
+  for (size_t i = 0; i < m; i++) {
+    ops[i].idx = rng() % n;
+    ops[i].data = (void *)i;
+  }
+
+  ll_list_from_array(&list, items, n);
+  start = clock();
+  for (size_t i = 0; i < m; i++) {
+    ll_list_insert_after(&list, ops[i].idx, ops[i].data);
+  }
+  report("insert at random, ll_list_insert_after", m, seconds_since(start));
+  ll_list_destroy(&list);
+
+  ll_list_from_array(&list, items, n);
+  start = clock();
+  ll_list_insert_batch(&list, ops, m);
+  report("insert at random, ll_list_insert_batch", m, seconds_since(start));
+  ll_list_destroy(&list);
+
+  free(items);
+  free(ops);
+}
+
+/**
+ * Apply a stream of batches of per inserts to a 1000-node list, then free
+ * half of the nodes with ll_list_remove_if.
+ */
+static void bench_insert_batch_stream(size_t batches, size_t per) {
+  struct ll_insert_op *ops = malloc(per * sizeof(struct ll_insert_op));
+  void *items[1000];
+  struct ll_list list;
+  char name[64];
+  clock_t start;
+
+  if (ops == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < 1000; i++) {
+    items[i] = (void *)i;
+  }
+
+  ll_list_from_array(&list, items, 1000);
+  start = clock();
+  for (size_t b = 0; b < batches; b++) {
+    for (size_t i = 0; i < per; i++) {
+      ops[i].idx = rng() % list.length;
+      ops[i].data = (void *)i;
+    }
+    ll_list_insert_batch(&list, ops, per);
+  }
+  snprintf(name, sizeof(name), "insert %zu-op batches", per);
+  report(name, batches * per, seconds_since(start));
+  start = clock();
+  ll_list_remove_if(&list, is_odd, NULL, NULL);
+  snprintf(name, sizeof(name), "remove half after %zu-op batches", per);
+  report(name, 1000 + batches * per, seconds_since(start));
+  ll_list_destroy(&list);
+
+  free(ops);
+}
+
+/**
+ * Sort an n-element list of random keys with ll_list_sort_parallel on 1, 2,
+ * 4 and 8 threads. Scaling is bounded by the number of cores and by the
+ * last merge, which runs on one thread.
+ */
+static void bench_sort_parallel(size_t n) {
+  void **items = malloc(n * sizeof(void *));
+  struct ll_list list;
+  char name[64];
+  double start;
+
+  if (items == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    items[i] = (void *)rng();
+  }
+  for (size_t threads = 1; threads <= 8; threads *= 2) {
+    list_scattered(&list, items, n);
+    start = wall_seconds();
+    ll_list_sort_parallel(&list, cmp_key, NULL, threads);
+    snprintf(name, sizeof(name), "sort random, %zu threads (wall)", threads);
+    report(name, n, wall_seconds() - start);
+    ll_list_destroy(&list);
+  }
+  free(items);
+}
+
+/**
+ * Copy an n-element list to an array with ll_to_array_alloc and with
+ * ll_list_to_array_alloc.
+ */
+static void bench_to_array(struct ll_list *list, const char *alloc_name,
+                           const char *list_name) {
+  void **items;
+  size_t n;
+  clock_t start;
+
+  start = clock();
+  if (ll_to_array_alloc(list->head, &items, &n) == LL_FAIL) {
+    return;
+  }
+  report(alloc_name, list->length, seconds_since(start));
+  free(items);
+
+  start = clock();
+  if (ll_list_to_array_alloc(list, &items) == LL_FAIL) {
+    return;
+  }
+  report(list_name, list->length, seconds_since(start));
+  free(items);
+}
+
+/**
+ * Full traversal of an n-element list with ll_iterate and ll_to_array_alloc
+ * (sequential and scattered nodes) and with ull_iterate.
+ */
+static void bench_traverse(size_t n) {
+  struct ll_list list;
+  struct ull_list ulist;
+  size_t sum = 0;
+  clock_t start;
+
+  ll_list_init(&list);
+  ull_init(&ulist);
+  for (size_t i = 0; i < n; i++) {
+    if (ll_list_append(&list, (void *)i) == LL_FAIL ||
+        ull_append(&ulist, (void *)i) == LL_FAIL) {
+      fprintf(stderr, "traverse: out of memory at %zu elements\n", i);
+      ll_list_destroy(&list);
+      ull_destroy(&ulist);
+      return;
+    }
+  }
+
+  start = clock();
+  ll_iterate(list.head, sum_node, &sum);
+  report("traverse ll_iterate, sequential nodes", n, seconds_since(start));
+  bench_to_array(&list, "ll_to_array_alloc, sequential nodes",
+                 "ll_list_to_array_alloc, sequential nodes");
+
+  scatter(&list);
+  start = clock();
+  ll_iterate(list.head, sum_node, &sum);
+  report("traverse ll_iterate, scattered nodes", n, seconds_since(start));
+  bench_to_array(&list, "ll_to_array_alloc, scattered nodes",
+                 "ll_list_to_array_alloc, scattered nodes");
+
+  start = clock();
+  ull_iterate(&ulist, sum_data, &sum);
+  report("traverse ull_iterate", n, seconds_since(start));
+
+  if (sum == 0) {
+    printf("(checksum %zu)\n", sum);  // Keep the traversals from being elided
+  }
+  ll_list_destroy(&list);
+  ull_destroy(&ulist);
+}
+
+/**
+ * Random positional reads on an n-element list with ll_get, sl_get and
+ * tl_get. The skip list and the tree do sl_ops reads each.
+ */
+static void bench_random_get(size_t n, size_t ll_ops, size_t sl_ops) {
+  struct ll_list list;
+  struct sl_list slist;
+  struct tl_list tlist;
+  size_t sum = 0;
+  clock_t start;
+
+  ll_list_init(&list);
+  sl_init(&slist);
+  tl_init(&tlist);
+  for (size_t i = 0; i < n; i++) {
+    ll_list_append(&list, (void *)i);
+    sl_append(&slist, (void *)i);
+    tl_append(&tlist, (void *)i);
+  }
+
+  start = clock();
+  for (size_t i = 0; i < ll_ops; i++) {
+    sum += (size_t)ll_get_sz(list.head, rng() % n);
+  }
+  report("random get ll_get", ll_ops, seconds_since(start));
+
+  start = clock();
+  for (size_t i = 0; i < sl_ops; i++) {
+    sum += (size_t)sl_get(&slist, rng() % n);
+  }
+  report("random get sl_get", sl_ops, seconds_since(start));
+
+  start = clock();
+  for (size_t i = 0; i < sl_ops; i++) {
+    sum += (size_t)tl_get(&tlist, rng() % n);
+  }
+  report("random get tl_get", sl_ops, seconds_since(start));
+
+  if (sum == 0) {
+    printf("(checksum %zu)\n", sum);
+  }
+  ll_list_destroy(&list);
+  sl_destroy(&slist);
+  tl_destroy(&tlist);
+}
+
+/**
+ * Positional reads that start mid-list and move forward by 0-3 elements from
+ * the previous one, wrapping around at the end, with ll_get and with the
+ * finger in ll_list_get.
+ * ll_get does ll_ops reads, ll_list_get does finger_ops reads.
+ */
+static void bench_near_get(size_t n, size_t ll_ops, size_t finger_ops) {
+  struct ll_list list;
+  size_t sum = 0;
+  size_t idx = n / 2;
+  clock_t start;
+
+  ll_list_init(&list);
+  for (size_t i = 0; i < n; i++) {
+    ll_list_append(&list, (void *)i);
+  }
+
+  start = clock();
+  for (size_t i = 0; i < ll_ops; i++) {
+    idx = (idx + rng() % 4) % n;
+    sum += (size_t)ll_get_sz(list.head, idx);
+  }
+  report("near get ll_get", ll_ops, seconds_since(start));
+
+  idx = n / 2;
+  start = clock();
+  for (size_t i = 0; i < finger_ops; i++) {
+    idx = (idx + rng() % 4) % n;
+    sum += (size_t)ll_list_get(&list, idx);
+  }
+  report("near get ll_list_get (finger)", finger_ops, seconds_since(start));
+  printf("  finger hits %zu, misses %zu\n", list.finger_hits,
+         list.finger_misses);
+
+  if (sum == 0) {
+    printf("(checksum %zu)\n", sum);
+  }
+  ll_list_destroy(&list);
+}
+
+int main(int argc, char **argv) {
+  struct ll_pool pool;
+
+  if (argc > 1) {
+    char *end;
+    size_t n = (size_t)strtoull(argv[1], &end, 10);
+    if (*end != '\0' || n == 0) {
+      fprintf(stderr, "usage: %s [element count]\n", argv[0]);
+      return 1;
+    }
+    bench_traverse(n);
+    return 0;
+  }
+
+  bench_churn("churn append/delete, malloc", &ll_default_allocator);
+
+  ll_pool_init(&pool, 0, 4096);
+  bench_churn("churn append/delete, ll_pool", ll_pool_allocator(&pool));
+  ll_pool_destroy(&pool);
+
+  bench_build(1000000);
+  bench_small_blocks(1000000, 100);
+  bench_small_blocks(1000000, 1000);
+  bench_sort(1000000);
+  bench_sort_parallel(1000000);
+  bench_radix_sort(1000000, 16);
+  bench_radix_sort(1000000, 32);
+  bench_radix_sort(1000000, 64);
+
+  bench_merge_k(1000000, 2);
+  bench_merge_k(1000000, 16);
+  bench_merge_k(1000000, 256);
+
+  bench_remove_if(30000);
+  bench_insert_batch(100000, 10000);
+  bench_insert_batch_stream(2000, 16);
+
+  bench_random_get(100000, 1000, 1000000);
+  bench_near_get(100000, 1000, 1000000);
+
+  bench_traverse(1000000);
+  bench_traverse(10000000);
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+#include <stdlib.h>
+
+#include "doubly_linked_list.h"
+
+/**
+ * Allocate a node for @p list and link it between @p prev and @p next, either
+ * of which may be NULL at the ends of the list.
+ */
+static struct dll_node *node_link_new(struct dll_list *list, void *data,
+                                      struct dll_node *prev,
+                                      struct dll_node *next) {
+  struct dll_node *new =
+      list->alloc->alloc(list->alloc->ctx, sizeof(struct dll_node));
+  if (new == NULL) {
+    return NULL;
+  }
+  new->data = data;
+  new->prev = prev;
+  new->next = next;
+
+  if (prev == NULL) {
+    list->head = new;
+  } else {
+    prev->next = new;
+  }
+  if (next == NULL) {
+    list->tail = new;
+  } else {
+    next->prev = new;
+  }
+  list->length++;
+
+  return new;
+}
+
+enum ll_status dll_init(struct dll_list *list) {
+  return dll_init_with_allocator(list, &ll_default_allocator);
+}
+
+enum ll_status dll_init_with_allocator(struct dll_list *list,
+                                       const struct ll_allocator *alloc) {
+  if (list == NULL || alloc == NULL || alloc->alloc == NULL ||
+      alloc->free == NULL) {
+    return LL_FAIL;
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  list->alloc = alloc;
+  return LL_OK;
+}
+
+struct dll_node *dll_append(struct dll_list *list, void *data) {
+  if (list == NULL) {
+    return NULL;
+  }
+  return node_link_new(list, data, list->tail, NULL);
+}
+
+struct dll_node *dll_prepend(struct dll_list *list, void *data) {
+  if (list == NULL) {
+    return NULL;
+  }
+  return node_link_new(list, data, NULL, list->head);
+}
+
+struct dll_node *dll_insert_before(struct dll_list *list, struct dll_node *node,
+                                   void *data) {
+  if (list == NULL || node == NULL) {
+    return NULL;
+  }
+  return node_link_new(list, data, node->prev, node);
+}
+
+struct dll_node *dll_insert_after(struct dll_list *list, struct dll_node *node,
+                                  void *data) {
+  if (list == NULL || node == NULL) {
+    return NULL;
+  }
+  return node_link_new(list, data, node, node->next);
+}
+
+enum ll_status dll_unlink(struct dll_list *list, struct dll_node *node) {
+  if (list == NULL || node == NULL || list->length == 0) {
+    return LL_FAIL;
+  }
+
+  if (node->prev == NULL) {
+    list->head = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+  if (node->next == NULL) {
+    list->tail = node->prev;
+  } else {
+    node->next->prev = node->prev;
+  }
+  list->length--;
+  list->alloc->free(list->alloc->ctx, node);
+
+  return LL_OK;
+}
+
+enum ll_status dll_destroy(struct dll_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+
+  if (list->alloc->free_all != NULL) {
+    list->alloc->free_all(list->alloc->ctx);
+  } else {
+    struct dll_node *n = list->head;
+    struct dll_node *t = list->head;
+    while (n != NULL) {
+      t = n;
+      n = n->next;
+      list->alloc->free(list->alloc->ctx, t);
+    }
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  return LL_OK;
+}
+
+size_t dll_length(const struct dll_list *list) {
+  if (list == NULL) {
+    return 0;
+  }
+  return list->length;
+}
+
+void dll_iterate(struct dll_list *list,
+                 enum ll_status (*cb)(struct dll_node *node, void *cookie),
+                 void *cookie) {
+  if (list == NULL) {
+    return;
+  }
+  struct dll_node *n = list->head;
+  while (n != NULL) {
+    if (cb(n, cookie) == LL_FAIL) {
+      return;
+    }
+    n = n->next;
+  }
+}
+
+void dll_iterate_reverse(struct dll_list *list,
+                         enum ll_status (*cb)(struct dll_node *node,
+                                              void *cookie),
+                         void *cookie) {
+  if (list == NULL) {
+    return;
+  }
+  struct dll_node *n = list->tail;
+  while (n != NULL) {
+    if (cb(n, cookie) == LL_FAIL) {
+      return;
+    }
+    n = n->prev;
+  }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * Doubly linked list. Every node knows its predecessor, so a node can be
+ * unlinked or have a node inserted before it without walking the list, and the
+ * list can be iterated from either end. Status codes and the iteration
+ * callback contract are the same as in linked_list.h.
+ *
+ * Functions that create a node return it so that the caller can hold on to it
+ * (e.g. in a hash table for an LRU cache) and later pass it to dll_unlink,
+ * dll_insert_before or dll_insert_after.
+ */
+#ifndef DOUBLY_LINKED_LIST_H
+#define DOUBLY_LINKED_LIST_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+struct dll_node {
+  void *data;
+  struct dll_node *prev;
+  struct dll_node *next;
+};
+
+struct dll_list {
+  struct dll_node *head;
+  struct dll_node *tail;
+  size_t length;
+  const struct ll_allocator *alloc;
+};
+
+/**
+ * Initialize @p list to an empty list that allocates its nodes with
+ * ll_default_allocator.
+ */
+enum ll_status dll_init(struct dll_list *list);
+
+/**
+ * Initialize @p list to an empty list that allocates and frees its nodes with
+ * @p alloc. The allocator must outlive the list.
+ */
+enum ll_status dll_init_with_allocator(struct dll_list *list,
+                                       const struct ll_allocator *alloc);
+
+/**
+ * Append a new node with @p data to the tail of the list.
+ *
+ * @return the new node.
+ * @return NULL if the node could not be allocated.
+ */
+struct dll_node *dll_append(struct dll_list *list, void *data);
+
+/**
+ * Prepend a new node with @p data to the head of the list.
+ *
+ * @return the new node.
+ * @return NULL if the node could not be allocated.
+ */
+struct dll_node *dll_prepend(struct dll_list *list, void *data);
+
+/**
+ * Insert a new node with @p data right before @p node, which must be in
+ * @p list.
+ *
+ * @return the new node.
+ * @return NULL if the node could not be allocated.
+ */
+struct dll_node *dll_insert_before(struct dll_list *list, struct dll_node *node,
+                                   void *data);
+
+/**
+ * Insert a new node with @p data right after @p node, which must be in
+ * @p list.
+ *
+ * @return the new node.
+ * @return NULL if the node could not be allocated.
+ */
+struct dll_node *dll_insert_after(struct dll_list *list, struct dll_node *node,
+                                  void *data);
+
+/**
+ * Unlink @p node, which must be in @p list, and deallocate memory allocated
+ * for it. Does not walk the list.
+ */
+enum ll_status dll_unlink(struct dll_list *list, struct dll_node *node);
+
+/**
+ * Destroy the whole list and leave @p list empty so that it can be reused.
+ */
+enum ll_status dll_destroy(struct dll_list *list);
+
+/**
+ * Return number of nodes in the list. Does not walk the list.
+ */
+size_t dll_length(const struct dll_list *list);
+
+/**
+ * Iterate over the list from head to tail calling @p cb function at every node
+ * until every node is visited or until the @p cb function returns LL_FAIL.
+ * Same contract as ll_iterate.
+ */
+void dll_iterate(struct dll_list *list,
+                 enum ll_status (*cb)(struct dll_node *node, void *cookie),
+                 void *cookie);
+
+/**
+ * Same as dll_iterate but from tail to head.
+ */
+void dll_iterate_reverse(struct dll_list *list,
+                         enum ll_status (*cb)(struct dll_node *node,
+                                              void *cookie),
+                         void *cookie);
+
+#endif  // DOUBLY_LINKED_LIST_H
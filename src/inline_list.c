@@ -0,0 +1,215 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "inline_list.h"
+
+/**
+ * Allocate a node for @p list and copy @p elem into it.
+ */
+static struct inl_node *node_new(struct inl_list *list, const void *elem,
+                                 struct inl_node *next) {
+  struct inl_node *new = list->alloc->alloc(
+      list->alloc->ctx, sizeof(struct inl_node) + list->elem_size);
+  if (new == NULL) {
+    return NULL;
+  }
+  new->next = next;
+  memcpy(new->data, elem, list->elem_size);
+  return new;
+}
+
+static void node_free(struct inl_list *list, struct inl_node *node) {
+  list->alloc->free(list->alloc->ctx, node);
+}
+
+/**
+ * @return node at index @p idx. Index has to be in range.
+ */
+static struct inl_node *node_at(struct inl_list *list, size_t idx) {
+  if (idx == list->length - 1) {
+    return list->tail;
+  }
+  struct inl_node *n = list->head;
+  for (size_t i = 0; i < idx; i++) {
+    n = n->next;
+  }
+  return n;
+}
+
+enum ll_status inl_init(struct inl_list *list, size_t elem_size) {
+  return inl_init_with_allocator(list, elem_size, &ll_default_allocator);
+}
+
+enum ll_status inl_init_with_allocator(struct inl_list *list, size_t elem_size,
+                                       const struct ll_allocator *alloc) {
+  if (list == NULL || elem_size == 0 ||
+      elem_size > SIZE_MAX - sizeof(struct inl_node) || alloc == NULL ||
+      alloc->alloc == NULL || alloc->free == NULL) {
+    return LL_FAIL;
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  list->elem_size = elem_size;
+  list->alloc = alloc;
+  return LL_OK;
+}
+
+enum ll_status inl_append(struct inl_list *list, const void *elem) {
+  if (list == NULL || elem == NULL) {
+    return LL_FAIL;
+  }
+
+  struct inl_node *new = node_new(list, elem, NULL);
+  if (new == NULL) {
+    return LL_FAIL;
+  }
+
+  if (list->tail == NULL) {
+    list->head = new;
+  } else {
+    list->tail->next = new;
+  }
+  list->tail = new;
+  list->length++;
+
+  return LL_OK;
+}
+
+enum ll_status inl_prepend(struct inl_list *list, const void *elem) {
+  if (list == NULL || elem == NULL) {
+    return LL_FAIL;
+  }
+
+  struct inl_node *new = node_new(list, elem, list->head);
+  if (new == NULL) {
+    return LL_FAIL;
+  }
+
+  list->head = new;
+  if (list->tail == NULL) {
+    list->tail = new;
+  }
+  list->length++;
+
+  return LL_OK;
+}
+
+enum ll_status inl_insert_after(struct inl_list *list, size_t idx,
+                                const void *elem) {
+  if (list == NULL || elem == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+
+  if (idx == list->length - 1) {
+    return inl_append(list, elem);
+  }
+
+  struct inl_node *n = node_at(list, idx);
+  struct inl_node *new = node_new(list, elem, n->next);
+  if (new == NULL) {
+    return LL_FAIL;
+  }
+  n->next = new;
+  list->length++;
+
+  return LL_OK;
+}
+
+enum ll_status inl_set(struct inl_list *list, size_t idx, const void *elem) {
+  if (list == NULL || elem == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+  memcpy(node_at(list, idx)->data, elem, list->elem_size);
+  return LL_OK;
+}
+
+enum ll_status inl_delete(struct inl_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+
+  struct inl_node *n = list->head;
+
+  // Delete head
+  if (idx == 0) {
+    list->head = n->next;
+    if (list->head == NULL) {
+      list->tail = NULL;
+    }
+    node_free(list, n);
+    list->length--;
+    return LL_OK;
+  }
+
+  struct inl_node *p = node_at(list, idx - 1);
+  n = p->next;
+  p->next = n->next;
+  if (n == list->tail) {
+    list->tail = p;
+  }
+  node_free(list, n);
+  list->length--;
+
+  return LL_OK;
+}
+
+enum ll_status inl_destroy(struct inl_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+
+  if (list->alloc->free_all != NULL) {
+    list->alloc->free_all(list->alloc->ctx);
+  } else {
+    struct inl_node *n = list->head;
+    struct inl_node *t = list->head;
+    while (n != NULL) {
+      t = n;
+      n = n->next;
+      node_free(list, t);
+    }
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  return LL_OK;
+}
+
+void *inl_get(struct inl_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return NULL;
+  }
+  return node_at(list, idx)->data;
+}
+
+void *inl_data(struct inl_node *node) {
+  if (node == NULL) {
+    return NULL;
+  }
+  return node->data;
+}
+
+size_t inl_length(const struct inl_list *list) {
+  if (list == NULL) {
+    return 0;
+  }
+  return list->length;
+}
+
+void inl_iterate(struct inl_list *list,
+                 enum ll_status (*cb)(struct inl_node *node, void *cookie),
+                 void *cookie) {
+  if (list == NULL) {
+    return;
+  }
+  struct inl_node *n = list->head;
+  while (n != NULL) {
+    if (cb(n, cookie) == LL_FAIL) {
+      return;
+    }
+    n = n->next;
+  }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file
+ *
+ * Singly linked list that stores fixed-size elements inside its nodes instead
+ * of pointing to them. Each node is a single allocation of the next pointer
+ * followed by the element, so there is one allocation per element instead of
+ * two and no extra pointer to follow to get to the element.
+ *
+ * Element size is fixed when the list is initialized. Elements are copied in
+ * and accessed in place through pointers into the nodes. Elements start right
+ * after the next pointer, so they are pointer aligned.
+ */
+#ifndef INLINE_LIST_H
+#define INLINE_LIST_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+struct inl_node {
+  struct inl_node *next;
+  unsigned char data[];
+};
+
+struct inl_list {
+  struct inl_node *head;
+  struct inl_node *tail;
+  size_t length;
+  size_t elem_size;
+  const struct ll_allocator *alloc;
+};
+
+/**
+ * Initialize @p list to an empty list of @p elem_size byte elements that
+ * allocates its nodes with ll_default_allocator.
+ */
+enum ll_status inl_init(struct inl_list *list, size_t elem_size);
+
+/**
+ * Initialize @p list to an empty list of @p elem_size byte elements that
+ * allocates its nodes with @p alloc. Nodes are
+ * sizeof(struct inl_node) + @p elem_size bytes, which is the block size to
+ * use for an ll_pool backing the list.
+ */
+enum ll_status inl_init_with_allocator(struct inl_list *list, size_t elem_size,
+                                       const struct ll_allocator *alloc);
+
+/**
+ * Append a copy of the element pointed to by @p elem to the tail of the list.
+ */
+enum ll_status inl_append(struct inl_list *list, const void *elem);
+
+/**
+ * Prepend a copy of the element pointed to by @p elem to the head of the list.
+ */
+enum ll_status inl_prepend(struct inl_list *list, const void *elem);
+
+/**
+ * Insert a copy of the element pointed to by @p elem after the element at
+ * index @p idx.
+ */
+enum ll_status inl_insert_after(struct inl_list *list, size_t idx,
+                                const void *elem);
+
+/**
+ * Overwrite the element at index @p idx with a copy of @p elem.
+ */
+enum ll_status inl_set(struct inl_list *list, size_t idx, const void *elem);
+
+/**
+ * Delete the element at index @p idx and free its node.
+ */
+enum ll_status inl_delete(struct inl_list *list, size_t idx);
+
+/**
+ * Destroy the whole list and leave @p list empty so that it can be reused.
+ */
+enum ll_status inl_destroy(struct inl_list *list);
+
+/**
+ * @return pointer to the element stored at index @p idx. The pointer is valid
+ * until the element is deleted.
+ * @return NULL if @p idx is out of range.
+ */
+void *inl_get(struct inl_list *list, size_t idx);
+
+/**
+ * @return pointer to the element stored in @p node.
+ */
+void *inl_data(struct inl_node *node);
+
+/**
+ * Return number of elements in the list. Does not walk the list.
+ */
+size_t inl_length(const struct inl_list *list);
+
+/**
+ * Iterate over the list calling @p cb function at every node until every node
+ * is visited or until the @p cb function returns LL_FAIL. Same contract as
+ * ll_iterate. Use inl_data to get to the element.
+ */
+void inl_iterate(struct inl_list *list,
+                 enum ll_status (*cb)(struct inl_node *node, void *cookie),
+                 void *cookie);
+
+#endif  // INLINE_LIST_H
@@ -0,0 +1,105 @@
+#include <stdlib.h>
+
+#include "intrusive_list.h"
+
+enum ll_status il_append(struct il_node **head, struct il_node *node) {
+  if (head == NULL || node == NULL) {
+    return LL_FAIL;
+  }
+  node->next = NULL;
+
+  if (*head == NULL) {
+    *head = node;
+    return LL_OK;
+  }
+
+  struct il_node *n = *head;
+  while (n->next != NULL) {
+    n = n->next;
+  }
+  n->next = node;
+
+  return LL_OK;
+}
+
+enum ll_status il_prepend(struct il_node **head, struct il_node *node) {
+  if (head == NULL || node == NULL) {
+    return LL_FAIL;
+  }
+  node->next = *head;
+  *head = node;
+
+  return LL_OK;
+}
+
+enum ll_status il_insert_after(struct il_node **head, size_t idx,
+                               struct il_node *node) {
+  if (head == NULL || node == NULL) {
+    return LL_FAIL;
+  }
+
+  struct il_node *n = il_get(*head, idx);
+  if (n == NULL) {
+    return LL_FAIL;
+  }
+  node->next = n->next;
+  n->next = node;
+
+  return LL_OK;
+}
+
+struct il_node *il_delete(struct il_node **head, size_t idx) {
+  if (head == NULL || *head == NULL) {
+    return NULL;
+  }
+
+  struct il_node *n = *head;
+
+  // Delete head
+  if (idx == 0) {
+    *head = n->next;
+    n->next = NULL;
+    return n;
+  }
+
+  struct il_node *p = il_get(*head, idx - 1);
+  if (p == NULL || p->next == NULL) {
+    return NULL;
+  }
+  n = p->next;
+  p->next = n->next;
+  n->next = NULL;
+
+  return n;
+}
+
+struct il_node *il_get(struct il_node *head, size_t idx) {
+  size_t i = 0;
+  while (head != NULL && i < idx) {
+    i++;
+    head = head->next;
+  }
+  return head;
+}
+
+size_t il_length(struct il_node *head) {
+  size_t i = 0;
+  while (head != NULL) {
+    i++;
+    head = head->next;
+  }
+  return i;
+}
+
+void il_iterate(struct il_node *head,
+                enum ll_status (*cb)(struct il_node *node, void *cookie),
+                void *cookie) {
+  while (head != NULL) {
+    // Read next first so that the callback may free the struct holding the node
+    struct il_node *next = head->next;
+    if (cb(head, cookie) == LL_FAIL) {
+      return;
+    }
+    head = next;
+  }
+}
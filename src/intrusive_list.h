@@ -0,0 +1,75 @@
+/**
+ * @file
+ *
+ * Intrusive singly linked list. Instead of the list allocating a node that
+ * points to the data, the user embeds a struct il_node in their own struct and
+ * links that. The list never allocates or frees anything, and getting from a
+ * node to the user's struct is pointer arithmetic (il_container_of) instead of
+ * a load through a data pointer.
+ *
+ * Functions mirror the ones in linked_list.h and use the same status codes.
+ */
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+struct il_node {
+  struct il_node *next;
+};
+
+/**
+ * Get a pointer to the struct of type @p type that has the struct il_node
+ * pointed to by @p ptr embedded in it as @p member.
+ */
+#define il_container_of(ptr, type, member) \
+  ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/**
+ * Append @p node to the tail of the list.
+ */
+enum ll_status il_append(struct il_node **head, struct il_node *node);
+
+/**
+ * Prepend @p node to the head of the list.
+ */
+enum ll_status il_prepend(struct il_node **head, struct il_node *node);
+
+/**
+ * Insert @p node after the list node at index @p idx.
+ */
+enum ll_status il_insert_after(struct il_node **head, size_t idx,
+                               struct il_node *node);
+
+/**
+ * Unlink node at index @p idx. Nothing is freed, the node belongs to the
+ * caller.
+ *
+ * @return the unlinked node.
+ * @return NULL if @p idx is out of range.
+ */
+struct il_node *il_delete(struct il_node **head, size_t idx);
+
+/**
+ * @return node at index @p idx.
+ * @return NULL if @p idx is out of range.
+ */
+struct il_node *il_get(struct il_node *head, size_t idx);
+
+/**
+ * Return number of nodes in the list.
+ */
+size_t il_length(struct il_node *head);
+
+/**
+ * Iterate over the list calling @p cb function at every node until every node
+ * is visited or until the @p cb function returns LL_FAIL. Same contract as
+ * ll_iterate.
+ */
+void il_iterate(struct il_node *head,
+                enum ll_status (*cb)(struct il_node *node, void *cookie),
+                void *cookie);
+
+#endif  // INTRUSIVE_LIST_H
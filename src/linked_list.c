@@ -1,23 +1,389 @@
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "linked_list.h"
 
+static void *default_alloc(void *ctx, size_t size) {
+  (void)ctx;
+  return malloc(size);
+}
+
+static void default_free(void *ctx, void *ptr) {
+  (void)ctx;
+  free(ptr);
+}
+
+const struct ll_allocator ll_default_allocator = {.alloc = default_alloc,
+                                                  .free = default_free,
+                                                  .ctx = NULL,
+                                                  .free_all = NULL};
+
+/**
+ * Nodes allocated together by ll_list_append_array. @p live counts the nodes
+ * of the block that are still in a list. The blocks of a set form a treap
+ * ordered by address, with priorities hashed from the address, so that the
+ * block of a node is found in O(log blocks) without any allocation.
+ */
+struct ll_block {
+  struct ll_block *left;   // Blocks at lower addresses
+  struct ll_block *right;  // Blocks at higher addresses
+  size_t count;
+  size_t live;
+  struct ll_node nodes[];
+};
+
+/**
+ * Blocks whose nodes may be in a list. Lists that exchanged nodes share a
+ * set. When two sets have to be joined, the blocks of the smaller one are
+ * moved to the other and the emptied set forwards to it through @p merged.
+ * @p refs counts the lists and sets pointing here. @p hint is the block the
+ * last lookup found, since nodes freed one after another tend to share one.
+ */
+struct ll_block_set {
+  struct ll_block *root;
+  struct ll_block *hint;
+  size_t count;
+  struct ll_block_set *merged;
+  size_t refs;
+};
+
+static uint64_t block_priority(const struct ll_block *b) {
+  return (uint64_t)(uintptr_t)b * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * Split the treap at @p t into the blocks below @p key, left in @p lo, and
+ * the ones above it, left in @p hi.
+ */
+static void block_split(struct ll_block *t, uintptr_t key,
+                        struct ll_block **lo, struct ll_block **hi) {
+  if (t == NULL) {
+    *lo = NULL;
+    *hi = NULL;
+  } else if ((uintptr_t)t < key) {
+    block_split(t->right, key, &t->right, hi);
+    *lo = t;
+  } else {
+    block_split(t->left, key, lo, &t->left);
+    *hi = t;
+  }
+}
+
+/**
+ * Join the treaps @p lo and @p hi, all of whose blocks are below the blocks
+ * of @p hi.
+ * @return the joined treap.
+ */
+static struct ll_block *block_join(struct ll_block *lo, struct ll_block *hi) {
+  if (lo == NULL) {
+    return hi;
+  }
+  if (hi == NULL) {
+    return lo;
+  }
+  if (block_priority(lo) > block_priority(hi)) {
+    lo->right = block_join(lo->right, hi);
+    return lo;
+  }
+  hi->left = block_join(lo, hi->left);
+  return hi;
+}
+
+/**
+ * @return the treap at @p t with @p b added.
+ */
+static struct ll_block *block_insert(struct ll_block *t, struct ll_block *b) {
+  if (t == NULL || block_priority(b) > block_priority(t)) {
+    block_split(t, (uintptr_t)b, &b->left, &b->right);
+    return b;
+  }
+  if ((uintptr_t)b < (uintptr_t)t) {
+    t->left = block_insert(t->left, b);
+  } else {
+    t->right = block_insert(t->right, b);
+  }
+  return t;
+}
+
+/**
+ * @return the treap at @p t without @p b, which has to be in it.
+ */
+static struct ll_block *block_remove(struct ll_block *t, struct ll_block *b) {
+  if (t == b) {
+    return block_join(b->left, b->right);
+  }
+  if ((uintptr_t)b < (uintptr_t)t) {
+    t->left = block_remove(t->left, b);
+  } else {
+    t->right = block_remove(t->right, b);
+  }
+  return t;
+}
+
+/**
+ * @return the block of the treap at @p t holding @p node, or NULL if the node
+ * is not part of any block.
+ */
+static struct ll_block *block_find(struct ll_block *t,
+                                   const struct ll_node *node) {
+  uintptr_t p = (uintptr_t)node;
+  while (t != NULL) {
+    uintptr_t first = (uintptr_t)t->nodes;
+    if (p < first) {
+      t = t->left;
+    } else if (p >= first + t->count * sizeof(struct ll_node)) {
+      t = t->right;
+    } else {
+      return t;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Move every block of the treap at @p t into the treap at @p into.
+ */
+static void block_move_all(struct ll_block *t, struct ll_block **into) {
+  if (t == NULL) {
+    return;
+  }
+  block_move_all(t->left, into);
+  block_move_all(t->right, into);
+  *into = block_insert(*into, t);
+}
+
+/**
+ * Return every block of the treap at @p t to @p alloc.
+ */
+static void block_free_all(const struct ll_allocator *alloc,
+                           struct ll_block *t) {
+  if (t == NULL) {
+    return;
+  }
+  block_free_all(alloc, t->left);
+  block_free_all(alloc, t->right);
+  alloc->free(alloc->ctx, t);
+}
+
+/**
+ * Drop a reference to @p set and free the sets nobody points to anymore.
+ */
+static void block_set_release(const struct ll_allocator *alloc,
+                              struct ll_block_set *set) {
+  while (set != NULL && --set->refs == 0) {
+    struct ll_block_set *merged = set->merged;
+    alloc->free(alloc->ctx, set);
+    set = merged;
+  }
+}
+
+/**
+ * @return the block set of @p list after following merges, or NULL if the
+ * list has none. Points the list straight at the returned set.
+ */
+static struct ll_block_set *list_blocks(struct ll_list *list) {
+  struct ll_block_set *set = list->blocks;
+  if (set == NULL || set->merged == NULL) {
+    return set;
+  }
+  while (set->merged != NULL) {
+    set = set->merged;
+  }
+  set->refs++;
+  block_set_release(list->alloc, list->blocks);
+  list->blocks = set;
+  return set;
+}
+
+/**
+ * Make sure @p dst can free any node that came from a block of @p src. Both
+ * lists have to use the same allocator.
+ */
+static void list_share_blocks(struct ll_list *dst, struct ll_list *src) {
+  struct ll_block_set *from = list_blocks(src);
+  struct ll_block_set *to = list_blocks(dst);
+  if (from == NULL || from == to) {
+    return;
+  }
+  if (to == NULL) {
+    from->refs++;
+    dst->blocks = from;
+    return;
+  }
+
+  // Move the blocks of the smaller set over and leave a forward behind for
+  // other lists
+  if (from->count > to->count) {
+    struct ll_block_set *t = from;
+    from = to;
+    to = t;
+  }
+  block_move_all(from->root, &to->root);
+  to->count += from->count;
+  from->root = NULL;
+  from->hint = NULL;
+  from->count = 0;
+  from->merged = to;
+  to->refs++;
+  list_blocks(src);
+  list_blocks(dst);
+}
+
+/**
+ * Drop the block set reference of @p list once it has no nodes left, so that
+ * a handle emptied by moving or deleting its nodes holds on to nothing.
+ */
+static void list_drop_blocks(struct ll_list *list) {
+  if (list->head == NULL) {
+    block_set_release(list->alloc, list->blocks);
+    list->blocks = NULL;
+  }
+}
+
+/**
+ * Allocate a node for @p list with the list's allocator.
+ */
+static struct ll_node *list_node_new(struct ll_list *list, void *data,
+                                     struct ll_node *next) {
+  struct ll_node *new =
+      list->alloc->alloc(list->alloc->ctx, sizeof(struct ll_node));
+  if (new == NULL) {
+    return NULL;
+  }
+  new->data = data;
+  new->next = next;
+  return new;
+}
+
+/**
+ * Return a node of @p list to the list's allocator.
+ */
+static void list_node_free(struct ll_list *list, struct ll_node *node) {
+  struct ll_block_set *set = list_blocks(list);
+  struct ll_block *b = NULL;
+  if (set != NULL) {
+    b = set->hint;
+    if (b == NULL || (uintptr_t)node < (uintptr_t)b->nodes ||
+        (uintptr_t)node >= (uintptr_t)(b->nodes + b->count)) {
+      b = block_find(set->root, node);
+    }
+  }
+  if (b == NULL) {
+    list->alloc->free(list->alloc->ctx, node);
+    return;
+  }
+
+  // Node is part of a block, which is freed with its last node
+  set->hint = b;
+  if (--b->live == 0) {
+    set->root = block_remove(set->root, b);
+    set->hint = NULL;
+    set->count--;
+    list->alloc->free(list->alloc->ctx, b);
+  }
+}
+
+/**
+ * @return node of @p list at index @p idx, which has to be in range. Starts
+ * from the finger when it is at or before @p idx and leaves the finger on the
+ * returned node.
+ */
+static struct ll_node *list_seek(struct ll_list *list, size_t idx) {
+  struct ll_node *n;
+  size_t i;
+
+  if (idx == list->length - 1) {
+    n = list->tail;
+    i = idx;
+  } else if (list->finger != NULL && list->finger_idx <= idx) {
+    n = list->finger;
+    i = list->finger_idx;
+    list->finger_hits++;
+  } else {
+    n = list->head;
+    i = 0;
+    list->finger_misses++;
+  }
+  while (i < idx) {
+    n = n->next;
+    i++;
+  }
+
+  list->finger = n;
+  list->finger_idx = idx;
+  return n;
+}
+
+/**
+ * Keep the finger of @p list valid after a node was inserted at index @p idx.
+ */
+static void finger_inserted(struct ll_list *list, size_t idx) {
+  if (list->finger != NULL && list->finger_idx >= idx) {
+    list->finger_idx++;
+  }
+}
+
+/**
+ * Keep the finger of @p list valid after the node at index @p idx was
+ * deleted.
+ */
+static void finger_deleted(struct ll_list *list, size_t idx) {
+  if (list->finger == NULL || list->finger_idx < idx) {
+    return;
+  }
+  if (list->finger_idx == idx) {
+    list->finger = NULL;
+  } else {
+    list->finger_idx--;
+  }
+}
+
+/**
+ * Reverse the links of up to @p count nodes starting at @p first. The
+ * reversed chain starts at @p new_first and ends at @p first, whose next is
+ * set to NULL. The node after the chain is left in @p rest.
+ * @return number of nodes reversed.
+ */
+static size_t reverse_chain(struct ll_node *first, size_t count,
+                            struct ll_node **new_first,
+                            struct ll_node **rest) {
+  struct ll_node *prev = NULL;
+  struct ll_node *n = first;
+  size_t i = 0;
+  while (n != NULL && i < count) {
+    struct ll_node *next = n->next;
+    n->next = prev;
+    prev = n;
+    n = next;
+    i++;
+  }
+  *new_first = prev;
+  *rest = n;
+  return i;
+}
+
 enum ll_status ll_append(struct ll_node **head, void *data) {
+  return ll_append_new(head, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+struct ll_node *ll_append_new(struct ll_node **head, void *data) {
   if (head == NULL) {
-    return LL_FAIL;
+    return NULL;
   }
 
   struct ll_node *new = malloc(sizeof(struct ll_node));
   if (new == NULL) {
-    return LL_FAIL;
+    return NULL;
   }
   new->data = data;
   new->next = NULL;
 
   if (*head == NULL) {
     *head = new;
-    return LL_OK;
+    return new;
   }
 
   struct ll_node *n = *head;
@@ -26,152 +392,1919 @@ enum ll_status ll_append(struct ll_node **head, void *data) {
   }
   n->next = new;
 
-  return LL_OK;
+  return new;
 }
 
 enum ll_status ll_prepend(struct ll_node **head, void *data) {
+  return ll_prepend_new(head, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+struct ll_node *ll_prepend_new(struct ll_node **head, void *data) {
   if (head == NULL) {
-    return LL_FAIL;
+    return NULL;
   }
 
   struct ll_node *new = malloc(sizeof(struct ll_node));
   if (new == NULL) {
-    return LL_FAIL;
+    return NULL;
   }
   new->data = data;
   new->next = *head;
 
   *head = new;
 
-  return LL_OK;
+  return new;
 }
 
-enum ll_status ll_set(struct ll_node *head, unsigned int idx, void *data) {
-  unsigned int i = 0;
+enum ll_status ll_append_array(struct ll_node **head, void **items, size_t n) {
+  if (head == NULL || (items == NULL && n > 0)) {
+    return LL_FAIL;
+  }
+  if (n == 0) {
+    return LL_OK;
+  }
 
-  while (head != NULL && i < idx) {
-    i++;
-    head = head->next;
+  // Build the new nodes as a separate chain first so that running out of
+  // memory half way leaves the list untouched
+  struct ll_node *first = NULL;
+  struct ll_node *last = NULL;
+  for (size_t i = 0; i < n; i++) {
+    struct ll_node *new = malloc(sizeof(struct ll_node));
+    if (new == NULL) {
+      ll_destroy(&first);
+      return LL_FAIL;
+    }
+    new->data = items[i];
+    new->next = NULL;
+    if (last == NULL) {
+      first = new;
+    } else {
+      last->next = new;
+    }
+    last = new;
   }
 
-  if (head != NULL) {
-    head->data = data;
+  if (*head == NULL) {
+    *head = first;
     return LL_OK;
   }
 
-  return LL_FAIL;
+  struct ll_node *tail = *head;
+  while (tail->next != NULL) {
+    tail = tail->next;
+  }
+  tail->next = first;
+
+  return LL_OK;
 }
 
-enum ll_status ll_insert_after(struct ll_node **head, unsigned int idx,
-                               void *data) {
-  // Cannot insert after anything if list is empty, which means head could be
-  // a single pointer since the head is not going to be modified because
-  // inserting after precludes inserting before the head of the list. Double
-  // pointer is being kept for consistency with other node creating functions.
-  if (head == NULL || *head == NULL) {
+enum ll_status ll_from_array(struct ll_node **head, void **items, size_t n) {
+  if (head == NULL || *head != NULL) {
     return LL_FAIL;
   }
+  return ll_append_array(head, items, n);
+}
 
-  unsigned int i = 0;
-  struct ll_node *n = *head;
-  while (n != NULL && i < idx) {
-    i++;
-    n = n->next;
+enum ll_status ll_concat(struct ll_node **dst, struct ll_node **src) {
+  if (dst == NULL || src == NULL || dst == src) {
+    return LL_FAIL;
+  }
+  if (*src == NULL) {
+    return LL_OK;
+  }
+  if (*dst == NULL) {
+    *dst = *src;
+    *src = NULL;
+    return LL_OK;
+  }
+  if (*dst == *src) {
+    return LL_FAIL;
   }
 
-  if (i == idx && n != NULL) {
-    struct ll_node *new = malloc(sizeof(struct ll_node));
-    if (new == NULL) {
+  struct ll_node *tail = *dst;
+  while (tail->next != NULL) {
+    tail = tail->next;
+  }
+  tail->next = *src;
+  *src = NULL;
+
+  return LL_OK;
+}
+
+enum ll_status ll_splice(struct ll_node **dst, size_t pos,
+                         struct ll_node **src, size_t from, size_t count) {
+  if (dst == NULL || src == NULL || dst == src ||
+      (*dst != NULL && *dst == *src)) {
+    return LL_FAIL;
+  }
+
+  // Find the insertion point first so that a bad position changes nothing
+  struct ll_node *at = NULL;  // Node to insert after, NULL for the head
+  if (pos > 0) {
+    at = *dst;
+    for (size_t i = 1; at != NULL && i < pos; i++) {
+      at = at->next;
+    }
+    if (at == NULL) {
       return LL_FAIL;
     }
-    new->data = data;
-    new->next = n->next;
-    n->next = new;
-  } else {
+  }
+
+  // Node before the range, NULL when the range starts at the head
+  struct ll_node *prev = NULL;
+  struct ll_node *first = *src;
+  size_t i = 0;
+  while (first != NULL && i < from) {
+    prev = first;
+    first = first->next;
+    i++;
+  }
+  if (i < from) {
     return LL_FAIL;
   }
+  if (count == 0) {
+    return LL_OK;
+  }
+  if (first == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_node *last = first;
+  for (i = 1; last != NULL && i < count; i++) {
+    last = last->next;
+  }
+  if (last == NULL) {
+    return LL_FAIL;
+  }
+
+  if (prev == NULL) {
+    *src = last->next;
+  } else {
+    prev->next = last->next;
+  }
+  if (at == NULL) {
+    last->next = *dst;
+    *dst = first;
+  } else {
+    last->next = at->next;
+    at->next = first;
+  }
 
   return LL_OK;
 }
 
-enum ll_status ll_delete(struct ll_node **head, unsigned int idx) {
-  if (head == NULL || *head == NULL) {
+enum ll_status ll_split(struct ll_node **head, size_t idx,
+                        struct ll_node **second) {
+  if (head == NULL || second == NULL || head == second || *second != NULL) {
     return LL_FAIL;
   }
-
-  unsigned int i = 0;
-  struct ll_node *n = *head;
-  struct ll_node *p = *head;
-
-  // Delete head
   if (idx == 0) {
-    *head = (*head)->next;
-    free(n);
+    *second = *head;
+    *head = NULL;
     return LL_OK;
   }
 
-  while (p != NULL && n != NULL && i < idx) {
-    i++;
-    p = n;
+  struct ll_node *n = *head;
+  for (size_t i = 1; n != NULL && i < idx; i++) {
     n = n->next;
   }
-
-  if (i == idx && p != NULL && n != NULL) {
-    p->next = n->next;
-    free(n);
-  } else {
+  if (n == NULL) {
     return LL_FAIL;
   }
+  *second = n->next;
+  n->next = NULL;
 
   return LL_OK;
 }
 
-enum ll_status ll_destroy(struct ll_node **head) {
-  if (head == NULL) {
+enum ll_status ll_split_n(struct ll_node **head, struct ll_node **parts,
+                          size_t k) {
+  if (head == NULL || parts == NULL || k == 0) {
     return LL_FAIL;
   }
+
+  // A plain list has to be walked once for its length before it can be cut
+  size_t len = ll_length_sz(*head);
   struct ll_node *n = *head;
-  struct ll_node *t = *head;
-  while (n != NULL) {
-    t = n;
+  *head = NULL;
+  for (size_t p = 0; p < k; p++) {
+    size_t part_len = len / k + (p < len % k ? 1 : 0);
+    if (part_len == 0) {
+      parts[p] = NULL;
+      continue;
+    }
+    parts[p] = n;
+    for (size_t i = 1; i < part_len; i++) {
+      n = n->next;
+    }
+    struct ll_node *last = n;
     n = n->next;
-    free(t);
+    last->next = NULL;
   }
 
-  *head = NULL;
   return LL_OK;
 }
 
-void *ll_get(struct ll_node *head, unsigned int idx) {
-  unsigned int i = 0;
-  while (head != NULL && i < idx) {
+enum ll_status ll_reverse(struct ll_node **head) {
+  if (head == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_node *rest;
+  reverse_chain(*head, SIZE_MAX, head, &rest);
+  return LL_OK;
+}
+
+enum ll_status ll_reverse_range(struct ll_node **head, size_t from,
+                                size_t count) {
+  if (head == NULL) {
+    return LL_FAIL;
+  }
+
+  // Node before the range, NULL when the range starts at the head
+  struct ll_node *prev = NULL;
+  struct ll_node *first = *head;
+  size_t i = 0;
+  while (first != NULL && i < from) {
+    prev = first;
+    first = first->next;
     i++;
-    head = head->next;
+  }
+  if (i < from) {
+    return LL_FAIL;
+  }
+  if (count == 0) {
+    return LL_OK;
   }
 
-  if (head != NULL && head->data != NULL) {
-    return head->data;
+  struct ll_node *new_first;
+  struct ll_node *rest;
+  size_t reversed = reverse_chain(first, count, &new_first, &rest);
+  if (reversed < count) {
+    // Range runs past the tail. Undo, which also restores the NULL at the
+    // end of the list.
+    reverse_chain(new_first, reversed, &new_first, &rest);
+    return LL_FAIL;
+  }
+  first->next = rest;
+  if (prev == NULL) {
+    *head = new_first;
   } else {
-    return NULL;
+    prev->next = new_first;
+  }
+
+  return LL_OK;
+}
+
+// Pending runs of sort_chain. Run k holds about 2^k runs of the input, so
+// this many levels cover any size_t node count.
+#define SORT_LEVELS (sizeof(size_t) * CHAR_BIT)
+
+/**
+ * Merge the sorted chains @p a and @p b, ending in @p a_tail and @p b_tail.
+ * Equal elements keep @p a first. The last node is left in @p tail.
+ * @return the first node of the merged chain.
+ */
+static struct ll_node *merge_chains(struct ll_node *a, struct ll_node *a_tail,
+                                    struct ll_node *b, struct ll_node *b_tail,
+                                    int (*cmp)(void *a, void *b, void *cookie),
+                                    void *cookie, struct ll_node **tail) {
+  struct ll_node *head = NULL;
+  struct ll_node **link = &head;
+  while (a != NULL && b != NULL) {
+    if (cmp(a->data, b->data, cookie) <= 0) {
+      *link = a;
+      a = a->next;
+    } else {
+      *link = b;
+      b = b->next;
+    }
+    link = &(*link)->next;
+  }
+  if (a != NULL) {
+    *link = a;
+    *tail = a_tail;
+  } else {
+    *link = b;
+    *tail = b_tail;
   }
+  return head;
 }
 
-unsigned int ll_length(struct ll_node *head) {
-  unsigned int i = 0;
-  while (head != NULL) {
-    i++;
-    head = head->next;
+/**
+ * Cut the longest sorted run off the front of the non-empty chain at
+ * @p head. A strictly descending run is reversed, so that sorted and reverse
+ * sorted input come off in one piece. The last node of the run is left in
+ * @p tail.
+ * @return the run, the rest of the chain is left in @p head.
+ */
+static struct ll_node *take_run(struct ll_node **head,
+                                int (*cmp)(void *a, void *b, void *cookie),
+                                void *cookie, struct ll_node **tail) {
+  struct ll_node *run = *head;
+  struct ll_node *last = run;
+  int descending =
+      last->next != NULL && cmp(last->data, last->next->data, cookie) > 0;
+
+  // Only a strictly descending run can be reversed without reordering equal
+  // elements
+  while (last->next != NULL &&
+         (cmp(last->data, last->next->data, cookie) > 0) == descending) {
+    last = last->next;
   }
-  return i;
+  *head = last->next;
+  last->next = NULL;
+  if (descending) {
+    struct ll_node *rest;
+    *tail = run;
+    reverse_chain(run, SIZE_MAX, &run, &rest);
+  } else {
+    *tail = last;
+  }
+  return run;
 }
 
-void ll_iterate(struct ll_node *head,
-                enum ll_status (*cb)(struct ll_node *node, void *cookie),
-                void *cookie) {
+/**
+ * Sort the chain starting at @p head with a bottom-up merge sort. Runs are
+ * merged into a binary counter of pending runs, the way std::list::sort
+ * does, instead of in full passes over the list. That keeps most merges on
+ * recently touched nodes. Extra space is the fixed array of pending runs.
+ * The last node is left in @p tail.
+ * @return the new first node.
+ */
+static struct ll_node *sort_chain(struct ll_node *head,
+                                  int (*cmp)(void *a, void *b, void *cookie),
+                                  void *cookie, struct ll_node **tail) {
+  struct ll_node *pending[SORT_LEVELS] = {NULL};
+  struct ll_node *pending_tail[SORT_LEVELS] = {NULL};
+  struct ll_node *last = NULL;
+
   while (head != NULL) {
-    if (cb(head, cookie) == LL_FAIL) {
-      return;
+    struct ll_node *run = take_run(&head, cmp, cookie, &last);
+    size_t k = 0;
+    // Pending runs hold earlier elements, so they go first for stability
+    while (k + 1 < SORT_LEVELS && pending[k] != NULL) {
+      run = merge_chains(pending[k], pending_tail[k], run, last, cmp, cookie,
+                         &last);
+      pending[k] = NULL;
+      k++;
     }
-    head = head->next;
+    if (pending[k] != NULL) {
+      run = merge_chains(pending[k], pending_tail[k], run, last, cmp, cookie,
+                         &last);
+    }
+    pending[k] = run;
+    pending_tail[k] = last;
   }
-}
\ No newline at end of file
+
+  for (size_t k = 0; k < SORT_LEVELS; k++) {
+    if (pending[k] == NULL) {
+      continue;
+    }
+    if (head == NULL) {
+      head = pending[k];
+      last = pending_tail[k];
+    } else {
+      head = merge_chains(pending[k], pending_tail[k], head, last, cmp, cookie,
+                          &last);
+    }
+  }
+  *tail = last;
+  return head;
+}
+
+// Upper bound on the threads of a parallel sort, so that the per-thread
+// state fits on the stack
+#define SORT_MAX_THREADS (64)
+
+// Segments shorter than this are not worth a thread of their own
+#define SORT_MIN_SEGMENT (4096)
+
+/**
+ * One segment of a parallel sort: sorted on its own, then merged with
+ * @p other.
+ */
+struct sort_task {
+  struct ll_node *head;
+  struct ll_node *tail;
+  struct ll_node *other;
+  struct ll_node *other_tail;
+  int (*cmp)(void *a, void *b, void *cookie);
+  void *cookie;
+};
+
+static void *sort_task_sort(void *arg) {
+  struct sort_task *t = arg;
+  t->head = sort_chain(t->head, t->cmp, t->cookie, &t->tail);
+  return NULL;
+}
+
+static void *sort_task_merge(void *arg) {
+  struct sort_task *t = arg;
+  t->head = merge_chains(t->head, t->tail, t->other, t->other_tail, t->cmp,
+                         t->cookie, &t->tail);
+  return NULL;
+}
+
+/**
+ * Run @p fn on each of the @p n @p tasks, each on its own thread except for
+ * the first, which runs on the calling thread. A task whose thread cannot
+ * be created runs on the calling thread too.
+ */
+static void run_tasks(struct sort_task *tasks, size_t n,
+                      void *(*fn)(void *arg)) {
+  pthread_t threads[SORT_MAX_THREADS];
+  int started[SORT_MAX_THREADS];
+
+  for (size_t i = 1; i < n; i++) {
+    started[i] = pthread_create(&threads[i], NULL, fn, &tasks[i]) == 0;
+  }
+  fn(&tasks[0]);
+  for (size_t i = 1; i < n; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    } else {
+      fn(&tasks[i]);
+    }
+  }
+}
+
+/**
+ * Sort the @p len node chain at @p head on up to @p nthreads threads: cut it
+ * into segments in one walk, sort the segments in parallel, then merge them
+ * pairwise, each round of merges in parallel. The last node is left in
+ * @p tail.
+ * @return the new first node.
+ */
+static struct ll_node *sort_chain_parallel(
+    struct ll_node *head, size_t len,
+    int (*cmp)(void *a, void *b, void *cookie), void *cookie, size_t nthreads,
+    struct ll_node **tail) {
+  struct sort_task tasks[SORT_MAX_THREADS];
+  size_t k = nthreads > SORT_MAX_THREADS ? SORT_MAX_THREADS : nthreads;
+  if (k > len / SORT_MIN_SEGMENT) {
+    k = len / SORT_MIN_SEGMENT;
+  }
+  if (k < 2) {
+    return sort_chain(head, cmp, cookie, tail);
+  }
+
+  for (size_t p = 0; p < k; p++) {
+    size_t seg_len = len / k + (p < len % k ? 1 : 0);
+    tasks[p].head = head;
+    for (size_t i = 1; i < seg_len; i++) {
+      head = head->next;
+    }
+    tasks[p].tail = head;
+    head = head->next;
+    tasks[p].tail->next = NULL;
+    tasks[p].cmp = cmp;
+    tasks[p].cookie = cookie;
+  }
+  run_tasks(tasks, k, sort_task_sort);
+
+  // Merge neighbours so that earlier segments stay first for stability
+  while (k > 1) {
+    size_t merges = k / 2;
+    for (size_t i = 0; i < merges; i++) {
+      tasks[i] = tasks[2 * i];
+      tasks[i].other = tasks[2 * i + 1].head;
+      tasks[i].other_tail = tasks[2 * i + 1].tail;
+    }
+    run_tasks(tasks, merges, sort_task_merge);
+    if (k % 2 == 1) {
+      tasks[merges] = tasks[k - 1];
+    }
+    k = merges + k % 2;
+  }
+
+  *tail = tasks[0].tail;
+  return tasks[0].head;
+}
+
+enum ll_status ll_sort(struct ll_node **head,
+                       int (*cmp)(void *a, void *b, void *cookie),
+                       void *cookie) {
+  if (head == NULL || cmp == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_node *tail;
+  *head = sort_chain(*head, cmp, cookie, &tail);
+  return LL_OK;
+}
+
+enum ll_status ll_sort_parallel(struct ll_node **head,
+                                int (*cmp)(void *a, void *b, void *cookie),
+                                void *cookie, size_t nthreads) {
+  if (head == NULL || cmp == NULL || nthreads == 0) {
+    return LL_FAIL;
+  }
+  struct ll_node *tail;
+  *head = sort_chain_parallel(*head, ll_length_sz(*head), cmp, cookie,
+                              nthreads, &tail);
+  return LL_OK;
+}
+
+// Radix sort digit width. 2^RADIX_BITS buckets of head and tail pointers
+// live on the stack.
+#define RADIX_BITS (11)
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+/**
+ * Distribute the chain starting at @p head over the buckets of the digit at
+ * @p shift, by relinking, and chain the buckets back together in order.
+ * Leaves the OR and AND of all keys in @p all_or and @p all_and and the last
+ * node in @p tail.
+ * @return the new first node.
+ */
+static struct ll_node *radix_pass(struct ll_node *head,
+                                  uint64_t (*key)(void *data, void *cookie),
+                                  void *cookie, unsigned int shift,
+                                  uint64_t *all_or, uint64_t *all_and,
+                                  struct ll_node **tail) {
+  struct ll_node *bucket_head[RADIX_BUCKETS];
+  struct ll_node *bucket_tail[RADIX_BUCKETS];
+  uint64_t k_or = 0;
+  uint64_t k_and = UINT64_MAX;
+
+  for (size_t b = 0; b < RADIX_BUCKETS; b++) {
+    bucket_head[b] = NULL;
+  }
+  for (struct ll_node *n = head; n != NULL; n = n->next) {
+    uint64_t k = key(n->data, cookie);
+    size_t b = (size_t)(k >> shift) & (RADIX_BUCKETS - 1);
+    k_or |= k;
+    k_and &= k;
+    if (bucket_head[b] == NULL) {
+      bucket_head[b] = n;
+    } else {
+      bucket_tail[b]->next = n;
+    }
+    bucket_tail[b] = n;
+  }
+
+  head = NULL;
+  for (size_t b = RADIX_BUCKETS; b-- > 0;) {
+    if (bucket_head[b] != NULL) {
+      if (head == NULL) {
+        *tail = bucket_tail[b];
+      }
+      bucket_tail[b]->next = head;
+      head = bucket_head[b];
+    }
+  }
+  *all_or = k_or;
+  *all_and = k_and;
+  return head;
+}
+
+/**
+ * LSD radix sort of the chain starting at @p head by the keys that @p key
+ * returns. The first pass also finds out which digits differ between keys,
+ * and the other digits are skipped. The last node is left in @p tail.
+ * @return the new first node.
+ */
+static struct ll_node *radix_sort_chain(
+    struct ll_node *head, uint64_t (*key)(void *data, void *cookie),
+    void *cookie, struct ll_node **tail) {
+  uint64_t all_or;
+  uint64_t all_and;
+  uint64_t ignored;
+
+  *tail = NULL;
+  if (head == NULL) {
+    return NULL;
+  }
+  head = radix_pass(head, key, cookie, 0, &all_or, &all_and, tail);
+  uint64_t varying = all_or ^ all_and;
+  for (unsigned int shift = RADIX_BITS; shift < 64; shift += RADIX_BITS) {
+    if (((varying >> shift) & (RADIX_BUCKETS - 1)) != 0) {
+      head = radix_pass(head, key, cookie, shift, &ignored, &ignored, tail);
+    }
+  }
+  return head;
+}
+
+enum ll_status ll_radix_sort(struct ll_node **head,
+                             uint64_t (*key)(void *data, void *cookie),
+                             void *cookie) {
+  if (head == NULL || key == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_node *tail;
+  *head = radix_sort_chain(*head, key, cookie, &tail);
+  return LL_OK;
+}
+
+enum ll_status ll_merge(struct ll_node **dst, struct ll_node **src,
+                        int (*cmp)(void *a, void *b, void *cookie),
+                        void *cookie) {
+  if (dst == NULL || src == NULL || dst == src || cmp == NULL ||
+      (*dst != NULL && *dst == *src)) {
+    return LL_FAIL;
+  }
+  struct ll_node *tail;
+  *dst = merge_chains(*dst, NULL, *src, NULL, cmp, cookie, &tail);
+  *src = NULL;
+  return LL_OK;
+}
+
+enum ll_status ll_merge_k(struct ll_node **lists, size_t k,
+                          int (*cmp)(void *a, void *b, void *cookie),
+                          void *cookie) {
+  if (lists == NULL || cmp == NULL) {
+    return LL_FAIL;
+  }
+
+  // Merge neighbours pairwise, doubling the distance every round, so every
+  // node takes part in about log2(k) merges and ties keep the list order
+  struct ll_node *tail;
+  for (size_t step = 1; step < k; step *= 2) {
+    for (size_t i = 0; i + step < k; i += 2 * step) {
+      lists[i] = merge_chains(lists[i], NULL, lists[i + step], NULL, cmp,
+                              cookie, &tail);
+      lists[i + step] = NULL;
+    }
+  }
+  return LL_OK;
+}
+
+enum ll_status ll_set(struct ll_node *head, unsigned int idx, void *data) {
+  return ll_set_sz(head, idx, data);
+}
+
+enum ll_status ll_set_sz(struct ll_node *head, size_t idx, void *data) {
+  size_t i = 0;
+
+  while (head != NULL && i < idx) {
+    i++;
+    head = head->next;
+  }
+
+  if (head != NULL) {
+    head->data = data;
+    return LL_OK;
+  }
+
+  return LL_FAIL;
+}
+
+enum ll_status ll_insert_after(struct ll_node **head, unsigned int idx,
+                               void *data) {
+  return ll_insert_after_new(head, idx, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+enum ll_status ll_insert_after_sz(struct ll_node **head, size_t idx,
+                                  void *data) {
+  return ll_insert_after_new(head, idx, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+struct ll_node *ll_insert_after_new(struct ll_node **head, size_t idx,
+                                    void *data) {
+  // Cannot insert after anything if list is empty, which means head could be
+  // a single pointer since the head is not going to be modified because
+  // inserting after precludes inserting before the head of the list. Double
+  // pointer is being kept for consistency with other node creating functions.
+  if (head == NULL || *head == NULL) {
+    return NULL;
+  }
+
+  size_t i = 0;
+  struct ll_node *n = *head;
+  while (n != NULL && i < idx) {
+    i++;
+    n = n->next;
+  }
+
+  if (i == idx && n != NULL) {
+    return ll_insert_after_node(n, data);
+  }
+
+  return NULL;
+}
+
+struct ll_node *ll_insert_after_node(struct ll_node *node, void *data) {
+  if (node == NULL) {
+    return NULL;
+  }
+
+  struct ll_node *new = malloc(sizeof(struct ll_node));
+  if (new == NULL) {
+    return NULL;
+  }
+  new->data = data;
+  new->next = node->next;
+  node->next = new;
+
+  return new;
+}
+
+// Batches of fewer inserts than this allocate their nodes one by one instead
+// of as a block
+#define BATCH_BLOCK_MIN (64)
+
+/**
+ * Insertion of a batch, with the node it goes after once that is known.
+ */
+struct batch_slot {
+  const struct ll_insert_op *op;
+  struct ll_node *after;
+};
+
+static int batch_slot_cmp(const void *a, const void *b) {
+  const struct ll_insert_op *x = ((const struct batch_slot *)a)->op;
+  const struct ll_insert_op *y = ((const struct batch_slot *)b)->op;
+  if (x->idx != y->idx) {
+    return x->idx < y->idx ? -1 : 1;
+  }
+  // Ties keep the order of the ops array
+  return (x > y) - (x < y);
+}
+
+/**
+ * @return the @p n ops in @p ops in index order, stable, in a malloc'd array.
+ * @return NULL if out of memory.
+ */
+static struct batch_slot *batch_slots(const struct ll_insert_op *ops,
+                                      size_t n) {
+  if (n > SIZE_MAX / sizeof(struct batch_slot)) {
+    return NULL;
+  }
+  struct batch_slot *slots = malloc(n * sizeof(struct batch_slot));
+  if (slots == NULL) {
+    return NULL;
+  }
+
+  int sorted = 1;
+  for (size_t i = 0; i < n; i++) {
+    slots[i].op = &ops[i];
+    slots[i].after = NULL;
+    if (i > 0 && ops[i].idx < ops[i - 1].idx) {
+      sorted = 0;
+    }
+  }
+  if (!sorted) {
+    qsort(slots, n, sizeof(struct batch_slot), batch_slot_cmp);
+  }
+  return slots;
+}
+
+/**
+ * Find the node each of the sorted @p slots goes after, walking forward from
+ * @p node at index @p idx, which is at or before the first of them.
+ */
+static enum ll_status batch_targets(struct batch_slot *slots, size_t n,
+                                    struct ll_node *node, size_t idx) {
+  for (size_t s = 0; s < n; s++) {
+    while (node != NULL && idx < slots[s].op->idx) {
+      node = node->next;
+      idx++;
+    }
+    if (node == NULL) {
+      return LL_FAIL;
+    }
+    slots[s].after = node;
+  }
+  return LL_OK;
+}
+
+/**
+ * Link the chain of new nodes starting at @p first, one per slot and in slot
+ * order, in after the nodes found by batch_targets.
+ * @return the last node linked in.
+ */
+static struct ll_node *batch_splice(const struct batch_slot *slots, size_t n,
+                                    struct ll_node *first) {
+  struct ll_node *at = NULL;
+  for (size_t s = 0; s < n; s++) {
+    struct ll_node *new = first;
+    first = first->next;
+    if (s == 0 || slots[s].after != slots[s - 1].after) {
+      at = slots[s].after;
+    }
+    new->next = at->next;
+    at->next = new;
+    at = new;
+  }
+  return at;
+}
+
+enum ll_status ll_insert_batch(struct ll_node **head,
+                               const struct ll_insert_op *ops, size_t n) {
+  if (head == NULL || (ops == NULL && n > 0)) {
+    return LL_FAIL;
+  }
+  if (n == 0) {
+    return LL_OK;
+  }
+
+  struct batch_slot *slots = batch_slots(ops, n);
+  if (slots == NULL) {
+    return LL_FAIL;
+  }
+  if (batch_targets(slots, n, *head, 0) == LL_FAIL) {
+    free(slots);
+    return LL_FAIL;
+  }
+
+  // All nodes up front, so running out of memory leaves the list untouched
+  struct ll_node *first = NULL;
+  struct ll_node **link = &first;
+  for (size_t s = 0; s < n; s++) {
+    struct ll_node *new = malloc(sizeof(struct ll_node));
+    if (new == NULL) {
+      *link = NULL;
+      ll_destroy(&first);
+      free(slots);
+      return LL_FAIL;
+    }
+    new->data = slots[s].op->data;
+    *link = new;
+    link = &new->next;
+  }
+  *link = NULL;
+
+  batch_splice(slots, n, first);
+  free(slots);
+  return LL_OK;
+}
+
+enum ll_status ll_delete_after_node(struct ll_node *node) {
+  if (node == NULL || node->next == NULL) {
+    return LL_FAIL;
+  }
+
+  struct ll_node *n = node->next;
+  node->next = n->next;
+  free(n);
+
+  return LL_OK;
+}
+
+enum ll_status ll_delete(struct ll_node **head, unsigned int idx) {
+  return ll_delete_sz(head, idx);
+}
+
+enum ll_status ll_delete_sz(struct ll_node **head, size_t idx) {
+  if (head == NULL || *head == NULL) {
+    return LL_FAIL;
+  }
+
+  size_t i = 0;
+  struct ll_node *n = *head;
+  struct ll_node *p = *head;
+
+  // Delete head
+  if (idx == 0) {
+    *head = (*head)->next;
+    free(n);
+    return LL_OK;
+  }
+
+  while (p != NULL && n != NULL && i < idx) {
+    i++;
+    p = n;
+    n = n->next;
+  }
+
+  if (i == idx && p != NULL && n != NULL) {
+    p->next = n->next;
+    free(n);
+  } else {
+    return LL_FAIL;
+  }
+
+  return LL_OK;
+}
+
+size_t ll_remove_if(struct ll_node **head,
+                    int (*pred)(void *data, void *cookie), void *cookie,
+                    void (*free_fn)(void *data)) {
+  if (head == NULL || pred == NULL) {
+    return 0;
+  }
+
+  size_t removed = 0;
+  struct ll_node **link = head;
+  while (*link != NULL) {
+    struct ll_node *n = *link;
+    if (pred(n->data, cookie)) {
+      *link = n->next;
+      if (free_fn != NULL) {
+        free_fn(n->data);
+      }
+      free(n);
+      removed++;
+    } else {
+      link = &n->next;
+    }
+  }
+  return removed;
+}
+
+size_t ll_move_if(struct ll_node **head,
+                  int (*pred)(void *data, void *cookie), void *cookie,
+                  struct ll_node **dst) {
+  if (head == NULL || pred == NULL || dst == NULL || dst == head ||
+      (*dst != NULL && *dst == *head)) {
+    return 0;
+  }
+
+  struct ll_node **out = dst;
+  while (*out != NULL) {
+    out = &(*out)->next;
+  }
+
+  size_t moved = 0;
+  struct ll_node **link = head;
+  while (*link != NULL) {
+    struct ll_node *n = *link;
+    if (pred(n->data, cookie)) {
+      *link = n->next;
+      *out = n;
+      out = &n->next;
+      moved++;
+    } else {
+      link = &n->next;
+    }
+  }
+  *out = NULL;
+  return moved;
+}
+
+enum ll_status ll_destroy(struct ll_node **head) {
+  if (head == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_node *n = *head;
+  struct ll_node *t = *head;
+  while (n != NULL) {
+    t = n;
+    n = n->next;
+    free(t);
+  }
+
+  *head = NULL;
+  return LL_OK;
+}
+
+void *ll_get(struct ll_node *head, unsigned int idx) {
+  return ll_get_sz(head, idx);
+}
+
+void *ll_get_sz(struct ll_node *head, size_t idx) {
+  size_t i = 0;
+  while (head != NULL && i < idx) {
+    i++;
+    head = head->next;
+  }
+
+  if (head != NULL && head->data != NULL) {
+    return head->data;
+  } else {
+    return NULL;
+  }
+}
+
+unsigned int ll_length(struct ll_node *head) {
+  size_t n = ll_length_sz(head);
+  return n > UINT_MAX ? UINT_MAX : (unsigned int)n;
+}
+
+size_t ll_length_sz(struct ll_node *head) {
+  size_t i = 0;
+  while (head != NULL) {
+    i++;
+    head = head->next;
+  }
+  return i;
+}
+
+void ll_iterate(struct ll_node *head,
+                enum ll_status (*cb)(struct ll_node *node, void *cookie),
+                void *cookie) {
+  while (head != NULL) {
+    if (cb(head, cookie) == LL_FAIL) {
+      return;
+    }
+    head = head->next;
+  }
+}
+
+size_t ll_to_array(struct ll_node *head, void **items, size_t cap) {
+  if (items == NULL) {
+    return 0;
+  }
+  size_t i = 0;
+  while (head != NULL && i < cap) {
+    items[i++] = head->data;
+    head = head->next;
+  }
+  return i;
+}
+
+enum ll_status ll_to_array_alloc(struct ll_node *head, void ***items,
+                                 size_t *n) {
+  if (items == NULL || n == NULL) {
+    return LL_FAIL;
+  }
+
+  // Grow the array while walking instead of walking once more for the length
+  void **arr = NULL;
+  size_t cap = 0;
+  size_t i = 0;
+  for (; head != NULL; head = head->next) {
+    if (i == cap) {
+      size_t new_cap = cap == 0 ? 16 : cap * 2;
+      void **t = NULL;
+      if (new_cap <= SIZE_MAX / sizeof(void *)) {
+        t = realloc(arr, new_cap * sizeof(void *));
+      }
+      if (t == NULL) {
+        free(arr);
+        return LL_FAIL;
+      }
+      arr = t;
+      cap = new_cap;
+    }
+    arr[i++] = head->data;
+  }
+
+  *items = arr;
+  *n = i;
+  return LL_OK;
+}
+
+enum ll_status ll_list_init(struct ll_list *list) {
+  return ll_list_init_with_allocator(list, &ll_default_allocator);
+}
+
+enum ll_status ll_list_init_with_allocator(struct ll_list *list,
+                                           const struct ll_allocator *alloc) {
+  if (list == NULL || alloc == NULL || alloc->alloc == NULL ||
+      alloc->free == NULL) {
+    return LL_FAIL;
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  list->alloc = alloc;
+  list->finger = NULL;
+  list->finger_idx = 0;
+  list->finger_hits = 0;
+  list->finger_misses = 0;
+  list->blocks = NULL;
+  return LL_OK;
+}
+
+enum ll_status ll_list_append(struct ll_list *list, void *data) {
+  return ll_list_append_new(list, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+struct ll_node *ll_list_append_new(struct ll_list *list, void *data) {
+  if (list == NULL) {
+    return NULL;
+  }
+
+  struct ll_node *new = list_node_new(list, data, NULL);
+  if (new == NULL) {
+    return NULL;
+  }
+
+  if (list->tail == NULL) {
+    list->head = new;
+  } else {
+    list->tail->next = new;
+  }
+  list->tail = new;
+  list->length++;
+
+  return new;
+}
+
+enum ll_status ll_list_prepend(struct ll_list *list, void *data) {
+  return ll_list_prepend_new(list, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+struct ll_node *ll_list_prepend_new(struct ll_list *list, void *data) {
+  if (list == NULL) {
+    return NULL;
+  }
+
+  struct ll_node *new = list_node_new(list, data, list->head);
+  if (new == NULL) {
+    return NULL;
+  }
+
+  list->head = new;
+  if (list->tail == NULL) {
+    list->tail = new;
+  }
+  list->length++;
+  finger_inserted(list, 0);
+
+  return new;
+}
+
+/**
+ * Allocate @p n nodes holding @p items as one block of @p list and link them
+ * up. Leaves the first and last node in @p first and @p last. The data is
+ * left NULL when @p items is NULL.
+ */
+static enum ll_status list_block_new(struct ll_list *list, void **items,
+                                     size_t n, struct ll_node **first,
+                                     struct ll_node **last) {
+  if (n > (SIZE_MAX - sizeof(struct ll_block)) / sizeof(struct ll_node)) {
+    return LL_FAIL;
+  }
+  struct ll_block_set *set = list_blocks(list);
+  if (set == NULL) {
+    set = list->alloc->alloc(list->alloc->ctx, sizeof(struct ll_block_set));
+    if (set == NULL) {
+      return LL_FAIL;
+    }
+    set->root = NULL;
+    set->hint = NULL;
+    set->count = 0;
+    set->merged = NULL;
+    set->refs = 1;
+    list->blocks = set;
+  }
+  struct ll_block *block = list->alloc->alloc(
+      list->alloc->ctx, sizeof(struct ll_block) + n * sizeof(struct ll_node));
+  if (block == NULL) {
+    return LL_FAIL;
+  }
+
+  block->count = n;
+  block->live = n;
+  for (size_t i = 0; i + 1 < n; i++) {
+    block->nodes[i].data = items == NULL ? NULL : items[i];
+    block->nodes[i].next = &block->nodes[i + 1];
+  }
+  block->nodes[n - 1].data = items == NULL ? NULL : items[n - 1];
+  block->nodes[n - 1].next = NULL;
+  set->root = block_insert(set->root, block);
+  set->count++;
+
+  *first = &block->nodes[0];
+  *last = &block->nodes[n - 1];
+  return LL_OK;
+}
+
+/**
+ * Same as list_block_new but allocates the nodes one by one.
+ */
+static enum ll_status list_chain_new(struct ll_list *list, void **items,
+                                     size_t n, struct ll_node **first,
+                                     struct ll_node **last) {
+  *first = NULL;
+  *last = NULL;
+  for (size_t i = 0; i < n; i++) {
+    struct ll_node *new =
+        list_node_new(list, items == NULL ? NULL : items[i], NULL);
+    if (new == NULL) {
+      while (*first != NULL) {
+        struct ll_node *t = *first;
+        *first = t->next;
+        list_node_free(list, t);
+      }
+      return LL_FAIL;
+    }
+    if (*last == NULL) {
+      *first = new;
+    } else {
+      (*last)->next = new;
+    }
+    *last = new;
+  }
+  return LL_OK;
+}
+
+enum ll_status ll_list_append_array(struct ll_list *list, void **items,
+                                    size_t n) {
+  if (list == NULL || (items == NULL && n > 0)) {
+    return LL_FAIL;
+  }
+  if (n == 0) {
+    return LL_OK;
+  }
+
+  struct ll_node *first;
+  struct ll_node *last;
+  if (list_block_new(list, items, n, &first, &last) == LL_FAIL &&
+      list_chain_new(list, items, n, &first, &last) == LL_FAIL) {
+    return LL_FAIL;
+  }
+
+  if (list->tail == NULL) {
+    list->head = first;
+  } else {
+    list->tail->next = first;
+  }
+  list->tail = last;
+  list->length += n;
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_from_array(struct ll_list *list, void **items,
+                                  size_t n) {
+  if (ll_list_init(list) == LL_FAIL) {
+    return LL_FAIL;
+  }
+  return ll_list_append_array(list, items, n);
+}
+
+enum ll_status ll_list_concat(struct ll_list *dst, struct ll_list *src) {
+  if (dst == NULL || src == NULL || dst == src || dst->alloc != src->alloc) {
+    return LL_FAIL;
+  }
+  if (src->head == NULL) {
+    return LL_OK;
+  }
+
+  list_share_blocks(dst, src);
+  if (dst->tail == NULL) {
+    dst->head = src->head;
+  } else {
+    dst->tail->next = src->head;
+  }
+  dst->tail = src->tail;
+  dst->length += src->length;
+
+  src->head = NULL;
+  src->tail = NULL;
+  src->length = 0;
+  src->finger = NULL;
+  list_drop_blocks(src);
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_splice(struct ll_list *dst, size_t pos,
+                              struct ll_list *src, size_t from, size_t count) {
+  if (dst == NULL || src == NULL || dst == src || dst->alloc != src->alloc ||
+      pos > dst->length || from > src->length || count > src->length - from) {
+    return LL_FAIL;
+  }
+  if (count == 0) {
+    return LL_OK;
+  }
+
+  // Unlink the range from src
+  struct ll_node *prev = from == 0 ? NULL : list_seek(src, from - 1);
+  struct ll_node *first = prev == NULL ? src->head : prev->next;
+  struct ll_node *last = first;
+  for (size_t i = 1; i < count; i++) {
+    last = last->next;
+  }
+  if (prev == NULL) {
+    src->head = last->next;
+  } else {
+    prev->next = last->next;
+  }
+  if (src->tail == last) {
+    src->tail = prev;
+  }
+  src->length -= count;
+  if (src->finger != NULL && src->finger_idx >= from) {
+    if (src->finger_idx < from + count) {
+      src->finger = NULL;
+    } else {
+      src->finger_idx -= count;
+    }
+  }
+
+  // Link it into dst
+  list_share_blocks(dst, src);
+  if (pos == 0) {
+    last->next = dst->head;
+    dst->head = first;
+  } else {
+    struct ll_node *at = list_seek(dst, pos - 1);
+    last->next = at->next;
+    at->next = first;
+  }
+  if (last->next == NULL) {
+    dst->tail = last;
+  }
+  if (dst->finger != NULL && dst->finger_idx >= pos) {
+    dst->finger_idx += count;
+  }
+  dst->length += count;
+  list_drop_blocks(src);
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_split(struct ll_list *list, size_t idx,
+                             struct ll_list *second) {
+  if (list == NULL || second == NULL || list == second ||
+      idx > list->length) {
+    return LL_FAIL;
+  }
+  ll_list_init_with_allocator(second, list->alloc);
+  if (idx == list->length) {
+    return LL_OK;
+  }
+  list_share_blocks(second, list);
+
+  if (idx == 0) {
+    second->head = list->head;
+    second->tail = list->tail;
+    second->length = list->length;
+    second->finger = list->finger;
+    second->finger_idx = list->finger_idx;
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->finger = NULL;
+    list_drop_blocks(list);
+    return LL_OK;
+  }
+
+  // Leaves the finger of list on its new tail
+  struct ll_node *n = list_seek(list, idx - 1);
+  second->head = n->next;
+  second->tail = list->tail;
+  second->length = list->length - idx;
+  n->next = NULL;
+  list->tail = n;
+  list->length = idx;
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_split_n(struct ll_list *list, struct ll_list *parts,
+                               size_t k) {
+  if (list == NULL || parts == NULL || k == 0) {
+    return LL_FAIL;
+  }
+  for (size_t p = 0; p < k; p++) {
+    if (&parts[p] == list) {
+      return LL_FAIL;
+    }
+  }
+
+  struct ll_node *n = list->head;
+  for (size_t p = 0; p < k; p++) {
+    size_t part_len = list->length / k + (p < list->length % k ? 1 : 0);
+    ll_list_init_with_allocator(&parts[p], list->alloc);
+    if (part_len == 0) {
+      continue;
+    }
+    list_share_blocks(&parts[p], list);
+    parts[p].head = n;
+    for (size_t i = 1; i < part_len; i++) {
+      n = n->next;
+    }
+    parts[p].tail = n;
+    parts[p].length = part_len;
+    n = n->next;
+    parts[p].tail->next = NULL;
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  list->finger = NULL;
+  list_drop_blocks(list);
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_reverse(struct ll_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return ll_list_reverse_range(list, 0, list->length);
+}
+
+enum ll_status ll_list_reverse_range(struct ll_list *list, size_t from,
+                                     size_t count) {
+  if (list == NULL || from > list->length || count > list->length - from) {
+    return LL_FAIL;
+  }
+  if (count < 2) {
+    return LL_OK;
+  }
+
+  // Seeking leaves the finger in front of the range, where it stays valid
+  struct ll_node *prev = from == 0 ? NULL : list_seek(list, from - 1);
+  struct ll_node *first = prev == NULL ? list->head : prev->next;
+  struct ll_node *new_first;
+  struct ll_node *rest;
+  reverse_chain(first, count, &new_first, &rest);
+  first->next = rest;
+  if (prev == NULL) {
+    list->head = new_first;
+  } else {
+    prev->next = new_first;
+  }
+  if (rest == NULL) {
+    list->tail = first;
+  }
+  if (list->finger != NULL && list->finger_idx >= from &&
+      list->finger_idx - from < count) {
+    list->finger_idx = from + (count - 1 - (list->finger_idx - from));
+  }
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_sort(struct ll_list *list,
+                            int (*cmp)(void *a, void *b, void *cookie),
+                            void *cookie) {
+  if (list == NULL || cmp == NULL) {
+    return LL_FAIL;
+  }
+  list->head = sort_chain(list->head, cmp, cookie, &list->tail);
+  list->finger = NULL;
+  return LL_OK;
+}
+
+enum ll_status ll_list_sort_parallel(
+    struct ll_list *list, int (*cmp)(void *a, void *b, void *cookie),
+    void *cookie, size_t nthreads) {
+  if (list == NULL || cmp == NULL || nthreads == 0) {
+    return LL_FAIL;
+  }
+  list->head = sort_chain_parallel(list->head, list->length, cmp, cookie,
+                                   nthreads, &list->tail);
+  list->finger = NULL;
+  return LL_OK;
+}
+
+enum ll_status ll_list_radix_sort(struct ll_list *list,
+                                  uint64_t (*key)(void *data, void *cookie),
+                                  void *cookie) {
+  if (list == NULL || key == NULL) {
+    return LL_FAIL;
+  }
+  list->head = radix_sort_chain(list->head, key, cookie, &list->tail);
+  list->finger = NULL;
+  return LL_OK;
+}
+
+/**
+ * Merge the sorted @p src into the sorted @p dst, leaving @p src empty.
+ * Arguments are checked by the caller.
+ */
+static void list_merge(struct ll_list *dst, struct ll_list *src,
+                       int (*cmp)(void *a, void *b, void *cookie),
+                       void *cookie) {
+  if (src->head != NULL) {
+    list_share_blocks(dst, src);
+    dst->head = merge_chains(dst->head, dst->tail, src->head, src->tail, cmp,
+                             cookie, &dst->tail);
+    dst->length += src->length;
+    dst->finger = NULL;
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->length = 0;
+    src->finger = NULL;
+  }
+  list_drop_blocks(src);
+}
+
+enum ll_status ll_list_merge(struct ll_list *dst, struct ll_list *src,
+                             int (*cmp)(void *a, void *b, void *cookie),
+                             void *cookie) {
+  if (dst == NULL || src == NULL || dst == src || cmp == NULL ||
+      dst->alloc != src->alloc) {
+    return LL_FAIL;
+  }
+  list_merge(dst, src, cmp, cookie);
+  return LL_OK;
+}
+
+enum ll_status ll_list_merge_k(struct ll_list *lists, size_t k,
+                               int (*cmp)(void *a, void *b, void *cookie),
+                               void *cookie) {
+  if (lists == NULL || cmp == NULL) {
+    return LL_FAIL;
+  }
+  for (size_t i = 1; i < k; i++) {
+    if (lists[i].alloc != lists[0].alloc) {
+      return LL_FAIL;
+    }
+  }
+
+  // Same merge tree as ll_merge_k
+  for (size_t step = 1; step < k; step *= 2) {
+    for (size_t i = 0; i + step < k; i += 2 * step) {
+      list_merge(&lists[i], &lists[i + step], cmp, cookie);
+    }
+  }
+  return LL_OK;
+}
+
+enum ll_status ll_list_insert_after(struct ll_list *list, size_t idx,
+                                    void *data) {
+  return ll_list_insert_after_new(list, idx, data) == NULL ? LL_FAIL : LL_OK;
+}
+
+struct ll_node *ll_list_insert_after_new(struct ll_list *list, size_t idx,
+                                         void *data) {
+  if (list == NULL || idx >= list->length) {
+    return NULL;
+  }
+
+  // Inserting after the tail is an append and does not need a walk
+  if (idx == list->length - 1) {
+    return ll_list_append_new(list, data);
+  }
+
+  struct ll_node *n = list_seek(list, idx);
+  struct ll_node *new = list_node_new(list, data, n->next);
+  if (new == NULL) {
+    return NULL;
+  }
+  n->next = new;
+  list->length++;
+  finger_inserted(list, idx + 1);
+
+  return new;
+}
+
+struct ll_node *ll_list_insert_after_node(struct ll_list *list,
+                                          struct ll_node *node, void *data) {
+  if (list == NULL || node == NULL) {
+    return NULL;
+  }
+
+  struct ll_node *new = list_node_new(list, data, node->next);
+  if (new == NULL) {
+    return NULL;
+  }
+  node->next = new;
+  if (list->tail == node) {
+    list->tail = new;
+  } else if (list->finger != node) {
+    // Index of the new node is unknown, so is whether the finger moved
+    list->finger = NULL;
+  }
+  list->length++;
+
+  return new;
+}
+
+enum ll_status ll_list_insert_batch(struct ll_list *list,
+                                    const struct ll_insert_op *ops, size_t n) {
+  if (list == NULL || (ops == NULL && n > 0)) {
+    return LL_FAIL;
+  }
+  if (n == 0) {
+    return LL_OK;
+  }
+
+  struct batch_slot *slots = batch_slots(ops, n);
+  if (slots == NULL) {
+    return LL_FAIL;
+  }
+  size_t lo = slots[0].op->idx;
+  if (slots[n - 1].op->idx >= list->length) {
+    free(slots);
+    return LL_FAIL;
+  }
+
+  // Small batches get nodes of their own, so that a stream of them does not
+  // pile up blocks
+  struct ll_node *first;
+  struct ll_node *last;
+  if ((n < BATCH_BLOCK_MIN ||
+       list_block_new(list, NULL, n, &first, &last) == LL_FAIL) &&
+      list_chain_new(list, NULL, n, &first, &last) == LL_FAIL) {
+    free(slots);
+    return LL_FAIL;
+  }
+  struct ll_node *new = first;
+  for (size_t s = 0; s < n; s++, new = new->next) {
+    new->data = slots[s].op->data;
+  }
+
+  // Indices are in range, so this cannot fail. The seek leaves the finger on
+  // the node at the lowest index, and every new node goes after it, so the
+  // finger index stays valid.
+  batch_targets(slots, n, list_seek(list, lo), lo);
+
+  last = batch_splice(slots, n, first);
+  if (slots[n - 1].after == list->tail) {
+    list->tail = last;
+  }
+  list->length += n;
+
+  free(slots);
+  return LL_OK;
+}
+
+enum ll_status ll_list_delete_after_node(struct ll_list *list,
+                                         struct ll_node *node) {
+  if (list == NULL || node == NULL || node->next == NULL) {
+    return LL_FAIL;
+  }
+
+  struct ll_node *n = node->next;
+  node->next = n->next;
+  if (list->tail == n) {
+    list->tail = node;
+  } else if (list->finger != node) {
+    // Index of the deleted node is unknown, so is whether the finger moved
+    list->finger = NULL;
+  }
+  if (list->finger == n) {
+    list->finger = NULL;
+  }
+  list_node_free(list, n);
+  list->length--;
+
+  return LL_OK;
+}
+
+enum ll_status ll_list_set(struct ll_list *list, size_t idx, void *data) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+  list_seek(list, idx)->data = data;
+  return LL_OK;
+}
+
+enum ll_status ll_list_delete(struct ll_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+
+  struct ll_node *n = list->head;
+
+  // Delete head
+  if (idx == 0) {
+    list->head = n->next;
+    if (list->head == NULL) {
+      list->tail = NULL;
+    }
+    list_node_free(list, n);
+    list->length--;
+    finger_deleted(list, 0);
+    list_drop_blocks(list);
+    return LL_OK;
+  }
+
+  struct ll_node *p = list_seek(list, idx - 1);
+  n = p->next;
+  p->next = n->next;
+  if (n == list->tail) {
+    list->tail = p;
+  }
+  list_node_free(list, n);
+  list->length--;
+  finger_deleted(list, idx);
+
+  return LL_OK;
+}
+
+size_t ll_list_remove_if(struct ll_list *list,
+                         int (*pred)(void *data, void *cookie), void *cookie,
+                         void (*free_fn)(void *data)) {
+  if (list == NULL || pred == NULL) {
+    return 0;
+  }
+
+  size_t removed = 0;
+  struct ll_node *last = NULL;
+  struct ll_node **link = &list->head;
+  while (*link != NULL) {
+    struct ll_node *n = *link;
+    if (pred(n->data, cookie)) {
+      *link = n->next;
+      if (free_fn != NULL) {
+        free_fn(n->data);
+      }
+      list_node_free(list, n);
+      removed++;
+    } else {
+      last = n;
+      link = &n->next;
+    }
+  }
+
+  if (removed > 0) {
+    list->tail = last;
+    list->length -= removed;
+    list->finger = NULL;
+    list_drop_blocks(list);
+  }
+  return removed;
+}
+
+size_t ll_list_move_if(struct ll_list *list,
+                       int (*pred)(void *data, void *cookie), void *cookie,
+                       struct ll_list *dst) {
+  if (list == NULL || pred == NULL || dst == NULL || dst == list ||
+      dst->alloc != list->alloc) {
+    return 0;
+  }
+
+  size_t moved = 0;
+  struct ll_node *last = NULL;
+  struct ll_node **out = dst->tail == NULL ? &dst->head : &dst->tail->next;
+  struct ll_node **link = &list->head;
+  while (*link != NULL) {
+    struct ll_node *n = *link;
+    if (pred(n->data, cookie)) {
+      *link = n->next;
+      *out = n;
+      out = &n->next;
+      dst->tail = n;
+      moved++;
+    } else {
+      last = n;
+      link = &n->next;
+    }
+  }
+  *out = NULL;
+
+  if (moved > 0) {
+    list_share_blocks(dst, list);
+    list->tail = last;
+    list->length -= moved;
+    list->finger = NULL;
+    dst->length += moved;
+    list_drop_blocks(list);
+  }
+  return moved;
+}
+
+enum ll_status ll_list_destroy(struct ll_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  if (list->alloc->free_all != NULL) {
+    list->alloc->free_all(list->alloc->ctx);
+  } else if (list_blocks(list) != NULL && list->blocks->refs == 1) {
+    // No other list can hold nodes of these blocks, so only the nodes outside
+    // of them are freed one by one and the blocks go back in one pass
+    struct ll_block_set *set = list->blocks;
+    struct ll_block *b = NULL;
+    struct ll_node *n = list->head;
+    while (n != NULL) {
+      struct ll_node *t = n;
+      n = n->next;
+      if (b == NULL || (uintptr_t)t < (uintptr_t)b->nodes ||
+          (uintptr_t)t >= (uintptr_t)(b->nodes + b->count)) {
+        struct ll_block *found = block_find(set->root, t);
+        if (found == NULL) {
+          list->alloc->free(list->alloc->ctx, t);
+          continue;
+        }
+        b = found;
+      }
+    }
+    block_free_all(list->alloc, set->root);
+    block_set_release(list->alloc, set);
+  } else {
+    struct ll_node *n = list->head;
+    struct ll_node *t = list->head;
+    while (n != NULL) {
+      t = n;
+      n = n->next;
+      list_node_free(list, t);
+    }
+    block_set_release(list->alloc, list->blocks);
+  }
+  list->blocks = NULL;
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  list->finger = NULL;
+  return LL_OK;
+}
+
+void *ll_list_get(struct ll_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return NULL;
+  }
+  return list_seek(list, idx)->data;
+}
+
+size_t ll_list_length(const struct ll_list *list) {
+  if (list == NULL) {
+    return 0;
+  }
+  return list->length;
+}
+
+enum ll_status ll_list_to_array_alloc(const struct ll_list *list,
+                                      void ***items) {
+  if (list == NULL || items == NULL ||
+      list->length > SIZE_MAX / sizeof(void *)) {
+    return LL_FAIL;
+  }
+  if (list->length == 0) {
+    *items = NULL;
+    return LL_OK;
+  }
+
+  void **arr = malloc(list->length * sizeof(void *));
+  if (arr == NULL) {
+    return LL_FAIL;
+  }
+  ll_to_array(list->head, arr, list->length);
+  *items = arr;
+  return LL_OK;
+}
+
+enum ll_status ll_cursor_init(struct ll_cursor *cur, struct ll_list *list) {
+  if (cur == NULL || list == NULL) {
+    return LL_FAIL;
+  }
+  cur->list = list;
+  cur->node = list->head;
+  cur->idx = 0;
+  return LL_OK;
+}
+
+enum ll_status ll_cursor_next(struct ll_cursor *cur) {
+  if (cur == NULL || cur->node == NULL) {
+    return LL_FAIL;
+  }
+  cur->node = cur->node->next;
+  cur->idx++;
+  return cur->node == NULL ? LL_FAIL : LL_OK;
+}
+
+enum ll_status ll_cursor_seek(struct ll_cursor *cur, size_t idx) {
+  if (cur == NULL || idx >= cur->list->length) {
+    return LL_FAIL;
+  }
+
+  if (idx == cur->list->length - 1) {
+    cur->node = cur->list->tail;
+    cur->idx = idx;
+    return LL_OK;
+  }
+
+  // Restart from the head only if the target is behind the cursor
+  if (cur->node == NULL || idx < cur->idx) {
+    cur->node = cur->list->head;
+    cur->idx = 0;
+  }
+  while (cur->idx < idx) {
+    cur->node = cur->node->next;
+    cur->idx++;
+  }
+  return LL_OK;
+}
+
+void *ll_cursor_get(const struct ll_cursor *cur) {
+  if (cur == NULL || cur->node == NULL) {
+    return NULL;
+  }
+  return cur->node->data;
+}
+
+enum ll_status ll_cursor_set(struct ll_cursor *cur, void *data) {
+  if (cur == NULL || cur->node == NULL) {
+    return LL_FAIL;
+  }
+  cur->node->data = data;
+  return LL_OK;
+}
+
+enum ll_status ll_cursor_insert_after(struct ll_cursor *cur, void *data) {
+  if (cur == NULL || cur->node == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_list *list = cur->list;
+
+  struct ll_node *new = list_node_new(list, data, cur->node->next);
+  if (new == NULL) {
+    return LL_FAIL;
+  }
+  cur->node->next = new;
+  if (list->tail == cur->node) {
+    list->tail = new;
+  }
+  list->length++;
+  finger_inserted(list, cur->idx + 1);
+
+  return LL_OK;
+}
+
+enum ll_status ll_cursor_delete_next(struct ll_cursor *cur) {
+  if (cur == NULL || cur->node == NULL || cur->node->next == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_list *list = cur->list;
+
+  struct ll_node *n = cur->node->next;
+  cur->node->next = n->next;
+  if (list->tail == n) {
+    list->tail = cur->node;
+  }
+  list_node_free(list, n);
+  list->length--;
+  finger_deleted(list, cur->idx + 1);
+
+  return LL_OK;
+}
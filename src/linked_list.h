@@ -7,11 +7,94 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 struct ll_node {
   void *data;
   struct ll_node *next;
 };
 
+/**
+ * Node allocator. Lets a list handle get its nodes from somewhere other than
+ * malloc/free (e.g. a pool or an arena). @p ctx is passed back to all
+ * functions untouched.
+ *
+ * @p free_all is optional. When it is set, ll_list_destroy calls it once
+ * instead of calling @p free for every node, so it must release everything
+ * the allocator handed out.
+ */
+struct ll_allocator {
+  void *(*alloc)(void *ctx, size_t size);
+  void (*free)(void *ctx, void *ptr);
+  void *ctx;
+  void (*free_all)(void *ctx);
+};
+
+/**
+ * Allocator that uses malloc/free. Used by ll_list_init.
+ */
+extern const struct ll_allocator ll_default_allocator;
+
+/**
+ * List handle. Caches the tail and the number of nodes so that appending and
+ * getting the length of the list do not need to walk the list. The handle is
+ * only kept up to date by the ll_list_* functions. The head can still be
+ * passed to the read-only functions that take a plain head pointer (ll_get,
+ * ll_set, ll_length, ll_iterate, ll_to_array).
+ *
+ * The handle also keeps a finger: the last node a positional ll_list_*
+ * function walked to and its index. A positional call whose target is at or
+ * after the finger walks from the finger instead of from the head.
+ * finger_hits and finger_misses count walks that did and did not start from
+ * the finger.
+ *
+ * ll_list_append_array and ll_list_insert_batch allocate all of their nodes
+ * in one block. The handle keeps track of these blocks, and a block goes back
+ * to the allocator once the last of its nodes has been deleted. Lists that
+ * exchange nodes (e.g. ll_list_splice) share their block records, and the
+ * first exchange between two lists with blocks of their own moves the blocks
+ * of the smaller record into the larger one. Freeing a node costs a lookup in
+ * O(log blocks), and ll_list_destroy returns the blocks of a list that
+ * shares none in one pass.
+ */
+struct ll_list {
+  struct ll_node *head;
+  struct ll_node *tail;
+  size_t length;
+  const struct ll_allocator *alloc;
+  struct ll_node *finger;  // NULL when there is no valid finger
+  size_t finger_idx;
+  size_t finger_hits;
+  size_t finger_misses;
+  struct ll_block_set *blocks;  // Node blocks, see above
+};
+
+/**
+ * Cursor into a list handle. Remembers a node and its index so that walking
+ * the list position by position costs O(1) per step instead of a walk from
+ * the head for every position. A cursor past the end of the list has a NULL
+ * node.
+ *
+ * Changing the list other than through the cursor (e.g. ll_list_delete) may
+ * leave the cursor pointing at a freed node or the wrong index, so re-init
+ * the cursor afterwards.
+ */
+struct ll_cursor {
+  struct ll_list *list;
+  struct ll_node *node;
+  size_t idx;
+};
+
+/**
+ * One insertion of a batch for ll_insert_batch: @p data goes right after the
+ * node at index @p idx of the list as it was before the batch.
+ */
+struct ll_insert_op {
+  size_t idx;
+  void *data;
+};
+
 enum ll_status { LL_OK, LL_FAIL };
 
 /**
@@ -19,29 +102,221 @@ enum ll_status { LL_OK, LL_FAIL };
  */
 enum ll_status ll_append(struct ll_node **head, void *data);
 
+/**
+ * Same as ll_append but hands back the new node.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_append_new(struct ll_node **head, void *data);
+
 /**
  * Prepend a new node with @p data to the head of the list. I.e. insert before
  * the head.
  */
 enum ll_status ll_prepend(struct ll_node **head, void *data);
 
+/**
+ * Same as ll_prepend but hands back the new node.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_prepend_new(struct ll_node **head, void *data);
+
+/**
+ * Append @p n nodes holding @p items to the tail of the linked list. Walks to
+ * the tail once rather than once per item. Nodes are still allocated one by
+ * one, since ll_delete and ll_destroy free every node on its own. Either all
+ * items are appended or, on failure, the list is left unchanged.
+ */
+enum ll_status ll_append_array(struct ll_node **head, void **items, size_t n);
+
+/**
+ * Build a list holding @p n @p items. @p head has to point to an empty list.
+ */
+enum ll_status ll_from_array(struct ll_node **head, void **items, size_t n);
+
+/**
+ * Move all nodes of the list at @p src to the tail of the list at @p dst,
+ * leaving @p src empty. Walks @p dst to its tail, does not allocate.
+ */
+enum ll_status ll_concat(struct ll_node **dst, struct ll_node **src);
+
+/**
+ * Move @p count nodes starting at index @p from out of the list at @p src
+ * and into the list at @p dst, so that the first of them ends up at index
+ * @p pos. @p pos can be the length of @p dst to move the nodes to its tail.
+ * @p src and @p dst have to be different lists. Walks both lists up to the
+ * range boundaries, does not allocate.
+ */
+enum ll_status ll_splice(struct ll_node **dst, size_t pos,
+                         struct ll_node **src, size_t from, size_t count);
+
+/**
+ * Cut the list at @p head in front of index @p idx. Nodes from @p idx on
+ * move to the list at @p second, which has to be empty. @p idx can be the
+ * length of the list, which leaves @p second empty. Walks the list up to
+ * @p idx, does not allocate or free nodes.
+ */
+enum ll_status ll_split(struct ll_node **head, size_t idx,
+                        struct ll_node **second);
+
+/**
+ * Cut the list at @p head into @p k parts in order and leave the heads of the
+ * parts in @p parts. The first (length % @p k) parts get one node more than
+ * the rest. @p head is left empty. Walks the list once for its length and
+ * once more to cut it, does not allocate or free nodes.
+ */
+enum ll_status ll_split_n(struct ll_node **head, struct ll_node **parts,
+                          size_t k);
+
+/**
+ * Reverse the order of the list in place by rewiring the links. One walk,
+ * no allocation.
+ */
+enum ll_status ll_reverse(struct ll_node **head);
+
+/**
+ * Reverse the order of the @p count nodes starting at index @p from in place.
+ * Fails, leaving the list unchanged, if the range runs past the tail.
+ */
+enum ll_status ll_reverse_range(struct ll_node **head, size_t from,
+                                size_t count);
+
+/**
+ * Sort the list in place by relinking its nodes. @p cmp gets the data of two
+ * nodes and the opaque @p cookie that was passed by the caller, and returns
+ * a negative, zero or positive value like the qsort comparison function.
+ * Stable, O(n log n) comparisons, no allocation and no recursion.
+ */
+enum ll_status ll_sort(struct ll_node **head,
+                       int (*cmp)(void *a, void *b, void *cookie),
+                       void *cookie);
+
+/**
+ * Same as ll_sort but on up to @p nthreads threads (at most 64). The list is
+ * cut into one segment per thread, the segments are sorted in parallel and
+ * then merged pairwise, each round of merges in parallel. Lists too short to
+ * be worth it are sorted on the calling thread. @p cmp is called from
+ * several threads at once, so it has to be safe to do so. Walks the list
+ * once more than ll_sort to find its length.
+ */
+enum ll_status ll_sort_parallel(struct ll_node **head,
+                                int (*cmp)(void *a, void *b, void *cookie),
+                                void *cookie, size_t nthreads);
+
+/**
+ * Sort the list in place by the integer key that @p key returns for the data
+ * of each node and the opaque @p cookie. Stable LSD radix sort on 11-bit
+ * digits that relinks the nodes: no comparisons, no copying and no
+ * allocation. Walks the list once for the lowest digit and once more for
+ * each higher digit that differs between keys, so it is fastest for keys
+ * that use few bits. @p key is called several times per node.
+ */
+enum ll_status ll_radix_sort(struct ll_node **head,
+                             uint64_t (*key)(void *data, void *cookie),
+                             void *cookie);
+
+/**
+ * Merge the list at @p src, sorted by @p cmp, into the list at @p dst, sorted
+ * the same way, leaving @p src empty. Relinks the nodes in one walk without
+ * allocating. Equal elements keep the ones from @p dst first.
+ */
+enum ll_status ll_merge(struct ll_node **dst, struct ll_node **src,
+                        int (*cmp)(void *a, void *b, void *cookie),
+                        void *cookie);
+
+/**
+ * Merge the @p k lists in @p lists, each sorted by @p cmp, into @p lists[0],
+ * leaving the others empty. Merges neighbouring lists pairwise in rounds, so
+ * it takes O(n log k) comparisons and does not allocate. Equal elements keep
+ * the order of their lists in @p lists. The lists must be distinct.
+ */
+enum ll_status ll_merge_k(struct ll_node **lists, size_t k,
+                          int (*cmp)(void *a, void *b, void *cookie),
+                          void *cookie);
+
 /**
  * Set node at index @p idx to @p data. No new node is created. Data pointer is
  * simply changed to point to @p data.
  */
 enum ll_status ll_set(struct ll_node *head, unsigned int idx, void *data);
 
+/**
+ * Same as ll_set but takes a size_t index, for lists longer than UINT_MAX.
+ */
+enum ll_status ll_set_sz(struct ll_node *head, size_t idx, void *data);
+
 /**
  * Insert @p data after the list node at index @p idx.
  */
 enum ll_status ll_insert_after(struct ll_node **head, unsigned int idx,
                                void *data);
 
+/**
+ * Same as ll_insert_after but takes a size_t index.
+ */
+enum ll_status ll_insert_after_sz(struct ll_node **head, size_t idx,
+                                  void *data);
+
+/**
+ * Same as ll_insert_after but hands back the new node.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_insert_after_new(struct ll_node **head, size_t idx,
+                                    void *data);
+
+/**
+ * Insert @p data right after @p node. Does not walk the list.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_insert_after_node(struct ll_node *node, void *data);
+
+/**
+ * Apply the @p n insertions in @p ops in one walk of the list. Indices refer
+ * to the list before the batch, so earlier inserts do not shift later ones.
+ * Ops need not be sorted, and ops with the same index keep the order they
+ * have in @p ops. All nodes are allocated before the list is touched, and the
+ * list is left unchanged on failure (e.g. an index out of range).
+ */
+enum ll_status ll_insert_batch(struct ll_node **head,
+                               const struct ll_insert_op *ops, size_t n);
+
+/**
+ * Delete the node right after @p node and deallocate memory allocated for it.
+ * Does not walk the list.
+ */
+enum ll_status ll_delete_after_node(struct ll_node *node);
+
 /**
  * Delete node at index @p idx and deallocate memory allocated for it.
  */
 enum ll_status ll_delete(struct ll_node **head, unsigned int idx);
 
+/**
+ * Same as ll_delete but takes a size_t index.
+ */
+enum ll_status ll_delete_sz(struct ll_node **head, size_t idx);
+
+/**
+ * Delete every node whose data @p pred returns non-zero for, in one walk.
+ * @p free_fn, when not NULL, is called on the data of each deleted node.
+ * @return number of nodes deleted.
+ */
+size_t ll_remove_if(struct ll_node **head,
+                    int (*pred)(void *data, void *cookie), void *cookie,
+                    void (*free_fn)(void *data));
+
+/**
+ * Same as ll_remove_if but moves the matching nodes, in order, to the tail of
+ * the list at @p dst instead of deleting them. Nothing is allocated or freed.
+ * @return number of nodes moved.
+ */
+size_t ll_move_if(struct ll_node **head,
+                  int (*pred)(void *data, void *cookie), void *cookie,
+                  struct ll_node **dst);
+
 /**
  * Destroy the whole list. Dealocate memory allocated for the list.
  */
@@ -54,10 +329,21 @@ enum ll_status ll_destroy(struct ll_node **head);
 void *ll_get(struct ll_node *head, unsigned int idx);
 
 /**
- * Return number of nodes in the list.
+ * Same as ll_get but takes a size_t index.
+ */
+void *ll_get_sz(struct ll_node *head, size_t idx);
+
+/**
+ * Return number of nodes in the list. Saturates at UINT_MAX, use ll_length_sz
+ * for longer lists.
  */
 unsigned int ll_length(struct ll_node *head);
 
+/**
+ * Return number of nodes in the list as a size_t.
+ */
+size_t ll_length_sz(struct ll_node *head);
+
 /**
  * Iterate over the list calling @p cb function at every node until every node
  * is visited or until the @p cb function returns LL_FAIL to indicate that the
@@ -67,4 +353,293 @@ unsigned int ll_length(struct ll_node *head);
 void ll_iterate(struct ll_node *head,
                 enum ll_status (*cb)(struct ll_node *node, void *cookie),
                 void *cookie);
+
+/**
+ * Copy the data pointers of the first @p cap nodes of the list to @p items in
+ * list order.
+ * @return number of data pointers copied.
+ */
+size_t ll_to_array(struct ll_node *head, void **items, size_t cap);
+
+/**
+ * Copy the data pointers of all nodes of the list to a new array in a single
+ * walk of the list. The array is left in @p items and its length in @p n.
+ * The caller owns the array and releases it with free(). @p items is NULL
+ * for an empty list.
+ */
+enum ll_status ll_to_array_alloc(struct ll_node *head, void ***items,
+                                 size_t *n);
+
+/**
+ * Initialize @p list to an empty list that allocates its nodes with
+ * ll_default_allocator.
+ */
+enum ll_status ll_list_init(struct ll_list *list);
+
+/**
+ * Initialize @p list to an empty list that allocates and frees its nodes with
+ * @p alloc. The allocator must outlive the list.
+ */
+enum ll_status ll_list_init_with_allocator(struct ll_list *list,
+                                           const struct ll_allocator *alloc);
+
+/**
+ * Append a new node with @p data to the tail of the list. Does not walk the
+ * list.
+ */
+enum ll_status ll_list_append(struct ll_list *list, void *data);
+
+/**
+ * Same as ll_list_append but hands back the new node.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_list_append_new(struct ll_list *list, void *data);
+
+/**
+ * Prepend a new node with @p data to the head of the list.
+ */
+enum ll_status ll_list_prepend(struct ll_list *list, void *data);
+
+/**
+ * Same as ll_list_prepend but hands back the new node.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_list_prepend_new(struct ll_list *list, void *data);
+
+/**
+ * Append @p n nodes holding @p items to the tail of @p list. All nodes come
+ * from a single allocation of the list's allocator and are linked in one
+ * pass. If the allocator cannot provide a block that large (e.g. ll_pool),
+ * nodes are allocated one by one instead. Either all items are appended or,
+ * on failure, the list is left unchanged.
+ */
+enum ll_status ll_list_append_array(struct ll_list *list, void **items,
+                                    size_t n);
+
+/**
+ * Initialize @p list like ll_list_init and fill it with @p n @p items as
+ * ll_list_append_array does. @p list is empty on failure.
+ */
+enum ll_status ll_list_from_array(struct ll_list *list, void **items,
+                                  size_t n);
+
+/**
+ * Move all nodes of @p src to the tail of @p dst, leaving @p src empty. Both
+ * lists have to use the same allocator, since @p dst is going to free the
+ * nodes. Takes O(1) unless both lists have blocks from ll_list_append_array,
+ * in which case joining their block records costs O(b log B), with b blocks
+ * in the smaller and B in the larger record. The emptied @p src holds no
+ * memory and need not be destroyed.
+ */
+enum ll_status ll_list_concat(struct ll_list *dst, struct ll_list *src);
+
+/**
+ * Same as ll_splice for list handles. Walks @p src up to the end of the
+ * range and @p dst up to @p pos, starting from the fingers where possible.
+ * Both lists have to use the same allocator. A @p src left empty holds no
+ * memory.
+ */
+enum ll_status ll_list_splice(struct ll_list *dst, size_t pos,
+                              struct ll_list *src, size_t from, size_t count);
+
+/**
+ * Same as ll_split for list handles. @p second is initialized with the
+ * allocator of @p list without being destroyed first, so it must be
+ * uninitialized, destroyed, or emptied by ll_list_* calls (an empty handle
+ * holds no memory). Walks @p list up to @p idx, starting from the finger
+ * where possible. A @p list left empty holds no memory.
+ */
+enum ll_status ll_list_split(struct ll_list *list, size_t idx,
+                             struct ll_list *second);
+
+/**
+ * Same as ll_split_n for list handles. Each of the @p k handles in @p parts
+ * is initialized with the allocator of @p list without being destroyed
+ * first, so the same goes for them as for @p second of ll_list_split. The
+ * length is known, so this walks the list only once. The emptied @p list
+ * holds no memory.
+ */
+enum ll_status ll_list_split_n(struct ll_list *list, struct ll_list *parts,
+                               size_t k);
+
+/**
+ * Same as ll_reverse for list handles. The finger stays on its node.
+ */
+enum ll_status ll_list_reverse(struct ll_list *list);
+
+/**
+ * Same as ll_reverse_range for list handles. Walks to the range starting
+ * from the finger where possible.
+ */
+enum ll_status ll_list_reverse_range(struct ll_list *list, size_t from,
+                                     size_t count);
+
+/**
+ * Same as ll_sort for list handles.
+ */
+enum ll_status ll_list_sort(struct ll_list *list,
+                            int (*cmp)(void *a, void *b, void *cookie),
+                            void *cookie);
+
+/**
+ * Same as ll_sort_parallel for list handles. The length is known, so this
+ * does not need the extra walk.
+ */
+enum ll_status ll_list_sort_parallel(
+    struct ll_list *list, int (*cmp)(void *a, void *b, void *cookie),
+    void *cookie, size_t nthreads);
+
+/**
+ * Same as ll_radix_sort for list handles.
+ */
+enum ll_status ll_list_radix_sort(struct ll_list *list,
+                                  uint64_t (*key)(void *data, void *cookie),
+                                  void *cookie);
+
+/**
+ * Same as ll_merge for list handles. Both lists have to use the same
+ * allocator. The emptied @p src holds no memory.
+ */
+enum ll_status ll_list_merge(struct ll_list *dst, struct ll_list *src,
+                             int (*cmp)(void *a, void *b, void *cookie),
+                             void *cookie);
+
+/**
+ * Same as ll_merge_k for an array of @p k list handles, which all have to use
+ * the same allocator. The emptied handles hold no memory.
+ */
+enum ll_status ll_list_merge_k(struct ll_list *lists, size_t k,
+                               int (*cmp)(void *a, void *b, void *cookie),
+                               void *cookie);
+
+/**
+ * Set node at index @p idx to @p data.
+ */
+enum ll_status ll_list_set(struct ll_list *list, size_t idx, void *data);
+
+/**
+ * Insert @p data after the list node at index @p idx.
+ */
+enum ll_status ll_list_insert_after(struct ll_list *list, size_t idx,
+                                    void *data);
+
+/**
+ * Same as ll_list_insert_after but hands back the new node.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_list_insert_after_new(struct ll_list *list, size_t idx,
+                                         void *data);
+
+/**
+ * Insert @p data right after @p node, which must be in @p list. Does not walk
+ * the list. Drops the finger if its index may have changed.
+ * @return the new node.
+ * @return NULL on failure.
+ */
+struct ll_node *ll_list_insert_after_node(struct ll_list *list,
+                                          struct ll_node *node, void *data);
+
+/**
+ * Same as ll_insert_batch for list handles. The new nodes of a large batch
+ * come from a single block when the allocator can provide one.
+ */
+enum ll_status ll_list_insert_batch(struct ll_list *list,
+                                    const struct ll_insert_op *ops, size_t n);
+
+/**
+ * Delete the node right after @p node, which must be in @p list, and
+ * deallocate memory allocated for it. Does not walk the list. Drops the finger
+ * if its index may have changed.
+ */
+enum ll_status ll_list_delete_after_node(struct ll_list *list,
+                                         struct ll_node *node);
+
+/**
+ * Delete node at index @p idx and deallocate memory allocated for it.
+ */
+enum ll_status ll_list_delete(struct ll_list *list, size_t idx);
+
+/**
+ * Same as ll_remove_if for list handles.
+ */
+size_t ll_list_remove_if(struct ll_list *list,
+                         int (*pred)(void *data, void *cookie), void *cookie,
+                         void (*free_fn)(void *data));
+
+/**
+ * Same as ll_move_if for list handles. Both lists have to use the same
+ * allocator, otherwise nothing is moved. A @p list left empty holds no
+ * memory.
+ */
+size_t ll_list_move_if(struct ll_list *list,
+                       int (*pred)(void *data, void *cookie), void *cookie,
+                       struct ll_list *dst);
+
+/**
+ * Destroy the whole list. Deallocate memory allocated for the list and leave
+ * @p list empty so that it can be reused.
+ */
+enum ll_status ll_list_destroy(struct ll_list *list);
+
+/**
+ * @return node data at index specified by @p idx.
+ * @return NULL if @p idx is out of range.
+ */
+void *ll_list_get(struct ll_list *list, size_t idx);
+
+/**
+ * Return number of nodes in the list. Does not walk the list.
+ */
+size_t ll_list_length(const struct ll_list *list);
+
+/**
+ * Same as ll_to_array_alloc, but sizes the array from the length kept in the
+ * handle, so it is allocated exactly once. The length of the array is
+ * ll_list_length(@p list).
+ */
+enum ll_status ll_list_to_array_alloc(const struct ll_list *list,
+                                      void ***items);
+
+/**
+ * Point @p cur at index 0 of @p list.
+ */
+enum ll_status ll_cursor_init(struct ll_cursor *cur, struct ll_list *list);
+
+/**
+ * Move @p cur one node forward. Moving past the tail leaves the cursor past
+ * the end and returns LL_FAIL.
+ */
+enum ll_status ll_cursor_next(struct ll_cursor *cur);
+
+/**
+ * Move @p cur to index @p idx. Walks forward from the cursor's current node
+ * when @p idx is at or after it and only restarts from the head when @p idx is
+ * behind it. Seeking to the tail does not walk at all. The cursor is left
+ * where it was if @p idx is out of range.
+ */
+enum ll_status ll_cursor_seek(struct ll_cursor *cur, size_t idx);
+
+/**
+ * @return data of the node under @p cur.
+ * @return NULL if the cursor is past the end.
+ */
+void *ll_cursor_get(const struct ll_cursor *cur);
+
+/**
+ * Set data of the node under @p cur to @p data.
+ */
+enum ll_status ll_cursor_set(struct ll_cursor *cur, void *data);
+
+/**
+ * Insert @p data after the node under @p cur. The cursor stays where it is.
+ */
+enum ll_status ll_cursor_insert_after(struct ll_cursor *cur, void *data);
+
+/**
+ * Delete the node after the node under @p cur. The cursor stays where it is.
+ */
+enum ll_status ll_cursor_delete_next(struct ll_cursor *cur);
 #endif  // LINKED_LIST_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ll_arena.h"
+
+static void *arena_alloc(void *ctx, size_t size) {
+  return ll_arena_alloc(ctx, size);
+}
+
+static void arena_free(void *ctx, void *ptr) {
+  // Memory is only given back in bulk by ll_arena_reset
+  (void)ctx;
+  (void)ptr;
+}
+
+static void arena_free_all(void *ctx) { ll_arena_reset(ctx); }
+
+enum ll_status ll_arena_init(struct ll_arena *arena, size_t region_size) {
+  if (arena == NULL || region_size == 0 ||
+      region_size > SIZE_MAX - sizeof(struct ll_arena_region)) {
+    return LL_FAIL;
+  }
+  arena->region_size = region_size;
+  arena->regions = NULL;
+  arena->bump = NULL;
+  arena->bump_left = 0;
+  arena->allocator.alloc = arena_alloc;
+  arena->allocator.free = arena_free;
+  arena->allocator.ctx = arena;
+  arena->allocator.free_all = arena_free_all;
+  return LL_OK;
+}
+
+void *ll_arena_alloc(struct ll_arena *arena, size_t size) {
+  if (arena == NULL || size > SIZE_MAX - sizeof(void *)) {
+    return NULL;
+  }
+
+  // Keep every allocation pointer aligned
+  size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+  if (size > arena->bump_left) {
+    size_t region_size = size > arena->region_size ? size : arena->region_size;
+    if (region_size > SIZE_MAX - sizeof(struct ll_arena_region)) {
+      return NULL;
+    }
+    struct ll_arena_region *region =
+        malloc(sizeof(struct ll_arena_region) + region_size);
+    if (region == NULL) {
+      return NULL;
+    }
+    region->next = arena->regions;
+    region->size = region_size;
+    arena->regions = region;
+    arena->bump = (unsigned char *)(region + 1);
+    arena->bump_left = region_size;
+  }
+
+  void *ptr = arena->bump;
+  arena->bump += size;
+  arena->bump_left -= size;
+  return ptr;
+}
+
+enum ll_status ll_arena_reset(struct ll_arena *arena) {
+  if (arena == NULL) {
+    return LL_FAIL;
+  }
+  if (arena->regions == NULL) {
+    return LL_OK;
+  }
+
+  struct ll_arena_region *r = arena->regions->next;
+  struct ll_arena_region *t = r;
+  while (r != NULL) {
+    t = r;
+    r = r->next;
+    free(t);
+  }
+
+  arena->regions->next = NULL;
+  arena->bump = (unsigned char *)(arena->regions + 1);
+  arena->bump_left = arena->regions->size;
+  return LL_OK;
+}
+
+enum ll_status ll_arena_destroy(struct ll_arena *arena) {
+  if (arena == NULL) {
+    return LL_FAIL;
+  }
+  ll_arena_reset(arena);
+  free(arena->regions);
+
+  arena->regions = NULL;
+  arena->bump = NULL;
+  arena->bump_left = 0;
+  return LL_OK;
+}
+
+const struct ll_allocator *ll_arena_allocator(struct ll_arena *arena) {
+  if (arena == NULL) {
+    return NULL;
+  }
+  return &arena->allocator;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file
+ *
+ * Bump allocator for lists that are built, used and then thrown away as a
+ * whole. Allocations are carved sequentially out of large regions and are
+ * never freed individually: ll_list_delete on a list backed by an arena only
+ * unlinks the node, and ll_list_destroy releases every node in one
+ * ll_arena_reset call instead of walking the list.
+ *
+ * Because destroying a list resets the arena, an arena should back a single
+ * list (or a group of lists that are destroyed together).
+ */
+#ifndef LL_ARENA_H
+#define LL_ARENA_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+// Region header. Allocations follow it in the same malloc'd block.
+struct ll_arena_region {
+  struct ll_arena_region *next;
+  size_t size;
+};
+
+struct ll_arena {
+  size_t region_size;
+  struct ll_arena_region *regions;  // Newest region first
+  unsigned char *bump;              // Next free byte in the newest region
+  size_t bump_left;                 // Free bytes left in the newest region
+  struct ll_allocator allocator;
+};
+
+/**
+ * Initialize @p arena to allocate memory from regions of @p region_size bytes.
+ * No memory is allocated until the first allocation.
+ */
+enum ll_status ll_arena_init(struct ll_arena *arena, size_t region_size);
+
+/**
+ * @return @p size bytes, pointer aligned, from the newest region. A new region
+ * is allocated when the newest one is full. Requests larger than the region
+ * size get a region of their own.
+ * @return NULL if a new region could not be allocated.
+ */
+void *ll_arena_alloc(struct ll_arena *arena, size_t size);
+
+/**
+ * Invalidate everything allocated from @p arena. The newest region is kept for
+ * reuse, all the others are released.
+ */
+enum ll_status ll_arena_reset(struct ll_arena *arena);
+
+/**
+ * Release all regions back to the system. The arena can be used again
+ * afterwards.
+ */
+enum ll_status ll_arena_destroy(struct ll_arena *arena);
+
+/**
+ * @return an allocator for ll_list_init_with_allocator that is backed by
+ * @p arena. Its free does nothing and its free_all resets the arena.
+ */
+const struct ll_allocator *ll_arena_allocator(struct ll_arena *arena);
+
+#endif  // LL_ARENA_H
@@ -0,0 +1,112 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ll_pool.h"
+
+static void *pool_alloc(void *ctx, size_t size) {
+  struct ll_pool *pool = ctx;
+  if (size > pool->block_size) {
+    return NULL;
+  }
+  return ll_pool_alloc(pool);
+}
+
+static void pool_free(void *ctx, void *ptr) { ll_pool_free(ctx, ptr); }
+
+enum ll_status ll_pool_init(struct ll_pool *pool, size_t block_size,
+                            size_t chunk_blocks) {
+  if (pool == NULL || chunk_blocks == 0) {
+    return LL_FAIL;
+  }
+  if (block_size == 0) {
+    block_size = sizeof(struct ll_node);
+  }
+
+  // A free block has to be able to hold the free list link, and every block
+  // has to stay pointer aligned.
+  if (block_size < sizeof(void *)) {
+    block_size = sizeof(void *);
+  }
+  block_size = (block_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  if (chunk_blocks > (SIZE_MAX - sizeof(struct ll_pool_chunk)) / block_size) {
+    return LL_FAIL;
+  }
+
+  pool->block_size = block_size;
+  pool->chunk_blocks = chunk_blocks;
+  pool->free_list = NULL;
+  pool->chunks = NULL;
+  pool->bump = NULL;
+  pool->bump_left = 0;
+  pool->allocator.alloc = pool_alloc;
+  pool->allocator.free = pool_free;
+  pool->allocator.ctx = pool;
+  pool->allocator.free_all = NULL;
+  return LL_OK;
+}
+
+void *ll_pool_alloc(struct ll_pool *pool) {
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  // Recycled blocks first
+  if (pool->free_list != NULL) {
+    void *block = pool->free_list;
+    pool->free_list = *(void **)block;
+    return block;
+  }
+
+  if (pool->bump_left == 0) {
+    struct ll_pool_chunk *chunk = malloc(sizeof(struct ll_pool_chunk) +
+                                         pool->block_size * pool->chunk_blocks);
+    if (chunk == NULL) {
+      return NULL;
+    }
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->bump = (unsigned char *)(chunk + 1);
+    pool->bump_left = pool->chunk_blocks;
+  }
+
+  // Blocks in a new chunk are handed out in order instead of being pushed on
+  // the free list up front, so a chunk is never touched before it is used.
+  void *block = pool->bump;
+  pool->bump += pool->block_size;
+  pool->bump_left--;
+  return block;
+}
+
+void ll_pool_free(struct ll_pool *pool, void *ptr) {
+  if (pool == NULL || ptr == NULL) {
+    return;
+  }
+  *(void **)ptr = pool->free_list;
+  pool->free_list = ptr;
+}
+
+enum ll_status ll_pool_destroy(struct ll_pool *pool) {
+  if (pool == NULL) {
+    return LL_FAIL;
+  }
+  struct ll_pool_chunk *c = pool->chunks;
+  struct ll_pool_chunk *t = pool->chunks;
+  while (c != NULL) {
+    t = c;
+    c = c->next;
+    free(t);
+  }
+
+  pool->free_list = NULL;
+  pool->chunks = NULL;
+  pool->bump = NULL;
+  pool->bump_left = 0;
+  return LL_OK;
+}
+
+const struct ll_allocator *ll_pool_allocator(struct ll_pool *pool) {
+  if (pool == NULL) {
+    return NULL;
+  }
+  return &pool->allocator;
+}
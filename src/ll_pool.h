@@ -0,0 +1,68 @@
+/**
+ * @file
+ *
+ * Fixed-size block pool for list nodes. Blocks are carved out of large chunks
+ * and blocks that are freed are kept on a free list (threaded through the
+ * freed blocks themselves) for reuse, so once the pool has grown to the
+ * working set of a list, inserting and deleting nodes does not call malloc or
+ * free at all. Memory is only returned to the system by ll_pool_destroy.
+ *
+ * The pool plugs into a list handle through ll_pool_allocator.
+ */
+#ifndef LL_POOL_H
+#define LL_POOL_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+// Chunk header. Blocks follow it in the same allocation.
+struct ll_pool_chunk {
+  struct ll_pool_chunk *next;
+};
+
+struct ll_pool {
+  size_t block_size;
+  size_t chunk_blocks;
+  void *free_list;
+  struct ll_pool_chunk *chunks;
+  unsigned char *bump;  // Next never-used block in the newest chunk
+  size_t bump_left;     // Number of never-used blocks left in the newest chunk
+  struct ll_allocator allocator;
+};
+
+/**
+ * Initialize @p pool to hand out blocks of @p block_size bytes, allocating
+ * @p chunk_blocks blocks at a time. A @p block_size of 0 means
+ * sizeof(struct ll_node). No memory is allocated until the first block is
+ * requested.
+ */
+enum ll_status ll_pool_init(struct ll_pool *pool, size_t block_size,
+                            size_t chunk_blocks);
+
+/**
+ * @return a block of the pool's block size.
+ * @return NULL if a new chunk was needed and could not be allocated.
+ */
+void *ll_pool_alloc(struct ll_pool *pool);
+
+/**
+ * Return @p ptr, which must have come from ll_pool_alloc on the same pool, to
+ * the pool.
+ */
+void ll_pool_free(struct ll_pool *pool, void *ptr);
+
+/**
+ * Release all chunks back to the system. Every block handed out by the pool
+ * becomes invalid, so lists using the pool must be destroyed first. The pool
+ * can be used again afterwards.
+ */
+enum ll_status ll_pool_destroy(struct ll_pool *pool);
+
+/**
+ * @return an allocator for ll_list_init_with_allocator that is backed by
+ * @p pool. Requests for more than the pool's block size fail.
+ */
+const struct ll_allocator *ll_pool_allocator(struct ll_pool *pool);
+
+#endif  // LL_POOL_H
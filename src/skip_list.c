@@ -0,0 +1,248 @@
+#include <stdlib.h>
+
+#include "skip_list.h"
+
+// Seed for the level generator. Fixed so that runs are reproducible.
+#define SL_RNG_SEED (0x9e3779b97f4a7c15ULL)
+
+/**
+ * Pick a height for a new node: 1 with probability 3/4, 2 with probability
+ * 3/16 and so on.
+ */
+static size_t random_height(struct sl_list *list) {
+  // xorshift64
+  unsigned long long x = list->rng;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  list->rng = x;
+
+  size_t height = 1;
+  while (height < SL_MAX_LEVEL && (x & 3) == 0) {
+    height++;
+    x >>= 2;
+  }
+  return height;
+}
+
+/**
+ * Find, on every level in use, the last link array before position @p pos
+ * (i.e. whose element has an index below @p pos, or the head). Stores the
+ * link arrays in @p update and their positions, counted from 1 with the head
+ * at 0, in @p rank.
+ */
+static void find_before(struct sl_list *list, size_t pos,
+                        struct sl_link *update[SL_MAX_LEVEL],
+                        size_t rank[SL_MAX_LEVEL]) {
+  struct sl_link *links = list->head;
+  size_t r = 0;
+  for (size_t lvl = list->level; lvl-- > 0;) {
+    while (links[lvl].next != NULL && r + links[lvl].width <= pos) {
+      r += links[lvl].width;
+      links = links[lvl].next->links;
+    }
+    update[lvl] = links;
+    rank[lvl] = r;
+  }
+}
+
+/**
+ * @return node at index @p idx, which has to be in range.
+ */
+static struct sl_node *node_at(struct sl_list *list, size_t idx) {
+  struct sl_link *links = list->head;
+  struct sl_node *n = NULL;
+  size_t r = 0;
+  for (size_t lvl = list->level; lvl-- > 0;) {
+    while (links[lvl].next != NULL && r + links[lvl].width <= idx + 1) {
+      r += links[lvl].width;
+      n = links[lvl].next;
+      links = n->links;
+    }
+    if (r == idx + 1) {
+      break;
+    }
+  }
+  return n;
+}
+
+/**
+ * Insert @p data so that it ends up at index @p pos, 0 <= pos <= length.
+ */
+static enum ll_status insert_at(struct sl_list *list, size_t pos,
+                                void *data) {
+  struct sl_link *update[SL_MAX_LEVEL];
+  size_t rank[SL_MAX_LEVEL];
+  size_t height = random_height(list);
+
+  struct sl_node *new = list->alloc->alloc(
+      list->alloc->ctx,
+      sizeof(struct sl_node) + height * sizeof(struct sl_link));
+  if (new == NULL) {
+    return LL_FAIL;
+  }
+  new->data = data;
+  new->height = height;
+
+  find_before(list, pos, update, rank);
+  for (size_t lvl = list->level; lvl < height; lvl++) {
+    update[lvl] = list->head;
+    rank[lvl] = 0;
+  }
+  if (height > list->level) {
+    list->level = height;
+  }
+
+  // The new node is at position pos + 1. Split the links it sits under and
+  // widen the ones above it by one.
+  for (size_t lvl = 0; lvl < list->level; lvl++) {
+    struct sl_link *u = &update[lvl][lvl];
+    if (lvl < height) {
+      new->links[lvl].next = u->next;
+      new->links[lvl].width = rank[lvl] + u->width - pos;
+      u->next = new;
+      u->width = pos + 1 - rank[lvl];
+    } else if (u->next != NULL) {
+      u->width++;
+    }
+  }
+  list->length++;
+
+  return LL_OK;
+}
+
+enum ll_status sl_init(struct sl_list *list) {
+  return sl_init_with_allocator(list, &ll_default_allocator);
+}
+
+enum ll_status sl_init_with_allocator(struct sl_list *list,
+                                      const struct ll_allocator *alloc) {
+  if (list == NULL || alloc == NULL || alloc->alloc == NULL ||
+      alloc->free == NULL) {
+    return LL_FAIL;
+  }
+  for (size_t lvl = 0; lvl < SL_MAX_LEVEL; lvl++) {
+    list->head[lvl].next = NULL;
+    list->head[lvl].width = 0;
+  }
+  list->level = 0;
+  list->length = 0;
+  list->rng = SL_RNG_SEED;
+  list->alloc = alloc;
+  return LL_OK;
+}
+
+enum ll_status sl_append(struct sl_list *list, void *data) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return insert_at(list, list->length, data);
+}
+
+enum ll_status sl_prepend(struct sl_list *list, void *data) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return insert_at(list, 0, data);
+}
+
+enum ll_status sl_set(struct sl_list *list, size_t idx, void *data) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+  node_at(list, idx)->data = data;
+  return LL_OK;
+}
+
+enum ll_status sl_insert_after(struct sl_list *list, size_t idx, void *data) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+  return insert_at(list, idx + 1, data);
+}
+
+enum ll_status sl_delete(struct sl_list *list, size_t idx) {
+  struct sl_link *update[SL_MAX_LEVEL] = {NULL};
+  size_t rank[SL_MAX_LEVEL];
+
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+
+  find_before(list, idx, update, rank);
+  struct sl_node *n = update[0][0].next;
+
+  // Links that jumped to the node now jump to where it jumped to. Links that
+  // jumped over it get one shorter.
+  for (size_t lvl = 0; lvl < list->level; lvl++) {
+    struct sl_link *u = &update[lvl][lvl];
+    if (lvl < n->height) {
+      u->next = n->links[lvl].next;
+      u->width += n->links[lvl].width - 1;
+    } else if (u->next != NULL) {
+      u->width--;
+    }
+  }
+  while (list->level > 0 && list->head[list->level - 1].next == NULL) {
+    list->level--;
+  }
+  list->length--;
+  list->alloc->free(list->alloc->ctx, n);
+
+  return LL_OK;
+}
+
+enum ll_status sl_destroy(struct sl_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+
+  if (list->alloc->free_all != NULL) {
+    list->alloc->free_all(list->alloc->ctx);
+  } else {
+    struct sl_node *n = list->head[0].next;
+    struct sl_node *t = n;
+    while (n != NULL) {
+      t = n;
+      n = n->links[0].next;
+      list->alloc->free(list->alloc->ctx, t);
+    }
+  }
+
+  for (size_t lvl = 0; lvl < SL_MAX_LEVEL; lvl++) {
+    list->head[lvl].next = NULL;
+    list->head[lvl].width = 0;
+  }
+  list->level = 0;
+  list->length = 0;
+  return LL_OK;
+}
+
+void *sl_get(struct sl_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return NULL;
+  }
+  return node_at(list, idx)->data;
+}
+
+size_t sl_length(const struct sl_list *list) {
+  if (list == NULL) {
+    return 0;
+  }
+  return list->length;
+}
+
+void sl_iterate(struct sl_list *list,
+                enum ll_status (*cb)(struct sl_node *node, void *cookie),
+                void *cookie) {
+  if (list == NULL) {
+    return;
+  }
+  struct sl_node *n = list->head[0].next;
+  while (n != NULL) {
+    if (cb(n, cookie) == LL_FAIL) {
+      return;
+    }
+    n = n->links[0].next;
+  }
+}
@@ -0,0 +1,109 @@
+/**
+ * @file
+ *
+ * Indexable skip list. Elements are kept in list order (not sorted), and
+ * every forward link on every level records how many elements it jumps over
+ * (its width). Summing widths while descending the levels finds an index in
+ * O(log n) expected time, so the positional functions (sl_get, sl_set,
+ * sl_insert_after, sl_delete) do not walk the list element by element.
+ *
+ * Index semantics and status codes are the same as the positional functions
+ * in linked_list.h.
+ */
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+// Upper bound on node height. With a level up probability of 1/4 this is
+// plenty for any list that fits in memory.
+#define SL_MAX_LEVEL (32)
+
+struct sl_node;
+
+struct sl_link {
+  struct sl_node *next;
+  size_t width;  // Number of elements this link advances by
+};
+
+struct sl_node {
+  void *data;
+  size_t height;
+  struct sl_link links[];  // One per level the node is on
+};
+
+struct sl_list {
+  struct sl_link head[SL_MAX_LEVEL];  // Links out of the head, no data
+  size_t level;                       // Number of levels in use
+  size_t length;
+  unsigned long long rng;  // State of the level generator
+  const struct ll_allocator *alloc;
+};
+
+/**
+ * Initialize @p list to an empty list that allocates its nodes with
+ * ll_default_allocator.
+ */
+enum ll_status sl_init(struct sl_list *list);
+
+/**
+ * Initialize @p list to an empty list that allocates and frees its nodes with
+ * @p alloc. Nodes vary in size with their height. The allocator must outlive
+ * the list.
+ */
+enum ll_status sl_init_with_allocator(struct sl_list *list,
+                                      const struct ll_allocator *alloc);
+
+/**
+ * Append @p data to the tail of the list.
+ */
+enum ll_status sl_append(struct sl_list *list, void *data);
+
+/**
+ * Prepend @p data to the head of the list.
+ */
+enum ll_status sl_prepend(struct sl_list *list, void *data);
+
+/**
+ * Set element at index @p idx to @p data.
+ */
+enum ll_status sl_set(struct sl_list *list, size_t idx, void *data);
+
+/**
+ * Insert @p data after the element at index @p idx.
+ */
+enum ll_status sl_insert_after(struct sl_list *list, size_t idx, void *data);
+
+/**
+ * Delete element at index @p idx and deallocate memory allocated for it.
+ */
+enum ll_status sl_delete(struct sl_list *list, size_t idx);
+
+/**
+ * Destroy the whole list and leave @p list empty so that it can be reused.
+ */
+enum ll_status sl_destroy(struct sl_list *list);
+
+/**
+ * @return element at index @p idx.
+ * @return NULL if @p idx is out of range.
+ */
+void *sl_get(struct sl_list *list, size_t idx);
+
+/**
+ * Return number of elements in the list. Does not walk the list.
+ */
+size_t sl_length(const struct sl_list *list);
+
+/**
+ * Iterate over the list in order calling @p cb function at every node until
+ * every node is visited or until the @p cb function returns LL_FAIL. Same
+ * contract as ll_iterate.
+ */
+void sl_iterate(struct sl_list *list,
+                enum ll_status (*cb)(struct sl_node *node, void *cookie),
+                void *cookie);
+
+#endif  // SKIP_LIST_H
@@ -0,0 +1,274 @@
+#include <stdlib.h>
+
+#include "tree_list.h"
+
+static size_t size(const struct tl_node *n) { return n == NULL ? 0 : n->size; }
+
+static int height(const struct tl_node *n) {
+  return n == NULL ? 0 : n->height;
+}
+
+/**
+ * Recompute size and height of @p n from its children.
+ */
+static void update(struct tl_node *n) {
+  int hl = height(n->left);
+  int hr = height(n->right);
+  n->size = size(n->left) + size(n->right) + 1;
+  n->height = (hl > hr ? hl : hr) + 1;
+}
+
+static struct tl_node *rotate_left(struct tl_node *n) {
+  struct tl_node *r = n->right;
+  n->right = r->left;
+  r->left = n;
+  update(n);
+  update(r);
+  return r;
+}
+
+static struct tl_node *rotate_right(struct tl_node *n) {
+  struct tl_node *l = n->left;
+  n->left = l->right;
+  l->right = n;
+  update(n);
+  update(l);
+  return l;
+}
+
+/**
+ * Restore the AVL balance of @p n, whose subtrees differ in height by at most
+ * two, and refresh its size and height.
+ * @return the new root of the subtree.
+ */
+static struct tl_node *rebalance(struct tl_node *n) {
+  int balance = height(n->left) - height(n->right);
+  if (balance > 1) {
+    if (height(n->left->left) < height(n->left->right)) {
+      n->left = rotate_left(n->left);
+    }
+    return rotate_right(n);
+  }
+  if (balance < -1) {
+    if (height(n->right->right) < height(n->right->left)) {
+      n->right = rotate_right(n->right);
+    }
+    return rotate_left(n);
+  }
+  update(n);
+  return n;
+}
+
+/**
+ * Insert @p new so that it ends up at position @p pos of the subtree @p n.
+ * @return the new root of the subtree.
+ */
+static struct tl_node *insert(struct tl_node *n, size_t pos,
+                              struct tl_node *new) {
+  if (n == NULL) {
+    return new;
+  }
+  size_t ls = size(n->left);
+  if (pos <= ls) {
+    n->left = insert(n->left, pos, new);
+  } else {
+    n->right = insert(n->right, pos - ls - 1, new);
+  }
+  return rebalance(n);
+}
+
+/**
+ * Unlink the leftmost node of the subtree @p n and store it in @p min.
+ * @return the new root of the subtree.
+ */
+static struct tl_node *remove_min(struct tl_node *n, struct tl_node **min) {
+  if (n->left == NULL) {
+    *min = n;
+    return n->right;
+  }
+  n->left = remove_min(n->left, min);
+  return rebalance(n);
+}
+
+/**
+ * Unlink the node at position @p pos of the subtree @p n and store it in
+ * @p removed.
+ * @return the new root of the subtree.
+ */
+static struct tl_node *remove_at(struct tl_node *n, size_t pos,
+                                 struct tl_node **removed) {
+  size_t ls = size(n->left);
+  if (pos < ls) {
+    n->left = remove_at(n->left, pos, removed);
+  } else if (pos > ls) {
+    n->right = remove_at(n->right, pos - ls - 1, removed);
+  } else {
+    *removed = n;
+    if (n->left == NULL) {
+      return n->right;
+    }
+    if (n->right == NULL) {
+      return n->left;
+    }
+    // Replace the node with its in-order successor
+    struct tl_node *succ;
+    struct tl_node *right = remove_min(n->right, &succ);
+    succ->left = n->left;
+    succ->right = right;
+    n = succ;
+  }
+  return rebalance(n);
+}
+
+/**
+ * @return node at index @p idx, which has to be in range.
+ */
+static struct tl_node *node_at(struct tl_list *list, size_t idx) {
+  struct tl_node *n = list->root;
+  for (;;) {
+    size_t ls = size(n->left);
+    if (idx < ls) {
+      n = n->left;
+    } else if (idx > ls) {
+      idx -= ls + 1;
+      n = n->right;
+    } else {
+      return n;
+    }
+  }
+}
+
+static void free_subtree(struct tl_list *list, struct tl_node *n) {
+  if (n == NULL) {
+    return;
+  }
+  free_subtree(list, n->left);
+  free_subtree(list, n->right);
+  list->alloc->free(list->alloc->ctx, n);
+}
+
+/**
+ * Insert @p data so that it ends up at index @p pos, 0 <= pos <= length.
+ */
+static enum ll_status insert_at(struct tl_list *list, size_t pos,
+                                void *data) {
+  struct tl_node *new =
+      list->alloc->alloc(list->alloc->ctx, sizeof(struct tl_node));
+  if (new == NULL) {
+    return LL_FAIL;
+  }
+  new->data = data;
+  new->left = NULL;
+  new->right = NULL;
+  new->size = 1;
+  new->height = 1;
+
+  list->root = insert(list->root, pos, new);
+  return LL_OK;
+}
+
+enum ll_status tl_init(struct tl_list *list) {
+  return tl_init_with_allocator(list, &ll_default_allocator);
+}
+
+enum ll_status tl_init_with_allocator(struct tl_list *list,
+                                      const struct ll_allocator *alloc) {
+  if (list == NULL || alloc == NULL || alloc->alloc == NULL ||
+      alloc->free == NULL) {
+    return LL_FAIL;
+  }
+  list->root = NULL;
+  list->alloc = alloc;
+  return LL_OK;
+}
+
+enum ll_status tl_append(struct tl_list *list, void *data) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return insert_at(list, size(list->root), data);
+}
+
+enum ll_status tl_prepend(struct tl_list *list, void *data) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return insert_at(list, 0, data);
+}
+
+enum ll_status tl_set(struct tl_list *list, size_t idx, void *data) {
+  if (list == NULL || idx >= size(list->root)) {
+    return LL_FAIL;
+  }
+  node_at(list, idx)->data = data;
+  return LL_OK;
+}
+
+enum ll_status tl_insert_after(struct tl_list *list, size_t idx, void *data) {
+  if (list == NULL || idx >= size(list->root)) {
+    return LL_FAIL;
+  }
+  return insert_at(list, idx + 1, data);
+}
+
+enum ll_status tl_delete(struct tl_list *list, size_t idx) {
+  if (list == NULL || idx >= size(list->root)) {
+    return LL_FAIL;
+  }
+  struct tl_node *removed = NULL;
+  list->root = remove_at(list->root, idx, &removed);
+  list->alloc->free(list->alloc->ctx, removed);
+  return LL_OK;
+}
+
+enum ll_status tl_destroy(struct tl_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  if (list->alloc->free_all != NULL) {
+    list->alloc->free_all(list->alloc->ctx);
+  } else {
+    free_subtree(list, list->root);
+  }
+  list->root = NULL;
+  return LL_OK;
+}
+
+void *tl_get(struct tl_list *list, size_t idx) {
+  if (list == NULL || idx >= size(list->root)) {
+    return NULL;
+  }
+  return node_at(list, idx)->data;
+}
+
+size_t tl_length(const struct tl_list *list) {
+  if (list == NULL) {
+    return 0;
+  }
+  return size(list->root);
+}
+
+void tl_iterate(struct tl_list *list,
+                enum ll_status (*cb)(struct tl_node *node, void *cookie),
+                void *cookie) {
+  struct tl_node *stack[TL_MAX_HEIGHT];
+  size_t top = 0;
+
+  if (list == NULL) {
+    return;
+  }
+
+  // Every node is pushed and popped once, so the whole walk is O(n)
+  struct tl_node *n = list->root;
+  while (n != NULL || top > 0) {
+    while (n != NULL) {
+      stack[top++] = n;
+      n = n->left;
+    }
+    n = stack[--top];
+    if (cb(n, cookie) == LL_FAIL) {
+      return;
+    }
+    n = n->right;
+  }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file
+ *
+ * List backed by an AVL tree ordered by position. Every node stores the size
+ * of its subtree, so the node at any index is found by descending from the
+ * root, and an insert or delete at any index rebalances only along that path.
+ * Positional functions are O(log n) in the worst case, tl_length is O(1), and
+ * in-order iteration is amortized O(1) per element.
+ *
+ * Index semantics and status codes are the same as the positional functions
+ * in linked_list.h.
+ */
+#ifndef TREE_LIST_H
+#define TREE_LIST_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+// Bound on AVL tree height for any size_t element count (1.44 * 64 + 2),
+// used to size the iteration stack.
+#define TL_MAX_HEIGHT (96)
+
+struct tl_node {
+  void *data;
+  struct tl_node *left;
+  struct tl_node *right;
+  size_t size;  // Number of nodes in the subtree rooted here
+  int height;
+};
+
+struct tl_list {
+  struct tl_node *root;
+  const struct ll_allocator *alloc;
+};
+
+/**
+ * Initialize @p list to an empty list that allocates its nodes with
+ * ll_default_allocator.
+ */
+enum ll_status tl_init(struct tl_list *list);
+
+/**
+ * Initialize @p list to an empty list that allocates and frees its nodes with
+ * @p alloc. The allocator must outlive the list.
+ */
+enum ll_status tl_init_with_allocator(struct tl_list *list,
+                                      const struct ll_allocator *alloc);
+
+/**
+ * Append @p data to the tail of the list.
+ */
+enum ll_status tl_append(struct tl_list *list, void *data);
+
+/**
+ * Prepend @p data to the head of the list.
+ */
+enum ll_status tl_prepend(struct tl_list *list, void *data);
+
+/**
+ * Set element at index @p idx to @p data.
+ */
+enum ll_status tl_set(struct tl_list *list, size_t idx, void *data);
+
+/**
+ * Insert @p data after the element at index @p idx.
+ */
+enum ll_status tl_insert_after(struct tl_list *list, size_t idx, void *data);
+
+/**
+ * Delete element at index @p idx and deallocate memory allocated for it.
+ */
+enum ll_status tl_delete(struct tl_list *list, size_t idx);
+
+/**
+ * Destroy the whole list and leave @p list empty so that it can be reused.
+ */
+enum ll_status tl_destroy(struct tl_list *list);
+
+/**
+ * @return element at index @p idx.
+ * @return NULL if @p idx is out of range.
+ */
+void *tl_get(struct tl_list *list, size_t idx);
+
+/**
+ * Return number of elements in the list. Does not walk the list.
+ */
+size_t tl_length(const struct tl_list *list);
+
+/**
+ * Iterate over the list in order calling @p cb function at every node until
+ * every node is visited or until the @p cb function returns LL_FAIL. Same
+ * contract as ll_iterate. The callback must not insert or delete elements.
+ */
+void tl_iterate(struct tl_list *list,
+                enum ll_status (*cb)(struct tl_node *node, void *cookie),
+                void *cookie);
+
+#endif  // TREE_LIST_H
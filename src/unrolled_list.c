@@ -0,0 +1,259 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "unrolled_list.h"
+
+static struct ull_node *node_new(struct ull_list *list) {
+  struct ull_node *new =
+      list->alloc->alloc(list->alloc->ctx, sizeof(struct ull_node));
+  if (new == NULL) {
+    return NULL;
+  }
+  new->next = NULL;
+  new->count = 0;
+  return new;
+}
+
+static void node_free(struct ull_list *list, struct ull_node *node) {
+  list->alloc->free(list->alloc->ctx, node);
+}
+
+/**
+ * Find the node holding the element at index @p idx, which has to be in range.
+ * Stores the element's offset within the node in @p off and the node before
+ * it (NULL for the head) in @p prev.
+ */
+static struct ull_node *locate(struct ull_list *list, size_t idx, size_t *off,
+                               struct ull_node **prev) {
+  struct ull_node *p = NULL;
+  struct ull_node *n = list->head;
+  while (idx >= n->count) {
+    idx -= n->count;
+    p = n;
+    n = n->next;
+  }
+  *off = idx;
+  if (prev != NULL) {
+    *prev = p;
+  }
+  return n;
+}
+
+/**
+ * Insert @p data so that it ends up at index @p pos, 0 <= pos <= length.
+ */
+static enum ll_status insert_at(struct ull_list *list, size_t pos,
+                                void *data) {
+  struct ull_node *n;
+  size_t off;
+
+  if (pos == list->length) {
+    n = list->tail;
+    if (n == NULL || n->count == ULL_NODE_CAPACITY) {
+      // Start a new tail rather than splitting the full one
+      struct ull_node *new = node_new(list);
+      if (new == NULL) {
+        return LL_FAIL;
+      }
+      if (n == NULL) {
+        list->head = new;
+      } else {
+        n->next = new;
+      }
+      list->tail = new;
+      n = new;
+    }
+    off = n->count;
+  } else {
+    n = locate(list, pos, &off, NULL);
+  }
+
+  if (n->count == ULL_NODE_CAPACITY) {
+    // Split: move the upper half into a new node after n
+    struct ull_node *new = node_new(list);
+    if (new == NULL) {
+      return LL_FAIL;
+    }
+    size_t keep = ULL_NODE_CAPACITY / 2;
+    new->count = ULL_NODE_CAPACITY - keep;
+    memcpy(new->data, &n->data[keep], new->count * sizeof(void *));
+    n->count = keep;
+    new->next = n->next;
+    n->next = new;
+    if (list->tail == n) {
+      list->tail = new;
+    }
+    if (off > keep) {
+      n = new;
+      off -= keep;
+    }
+  }
+
+  memmove(&n->data[off + 1], &n->data[off], (n->count - off) * sizeof(void *));
+  n->data[off] = data;
+  n->count++;
+  list->length++;
+
+  return LL_OK;
+}
+
+enum ll_status ull_init(struct ull_list *list) {
+  return ull_init_with_allocator(list, &ll_default_allocator);
+}
+
+enum ll_status ull_init_with_allocator(struct ull_list *list,
+                                       const struct ll_allocator *alloc) {
+  if (list == NULL || alloc == NULL || alloc->alloc == NULL ||
+      alloc->free == NULL) {
+    return LL_FAIL;
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  list->alloc = alloc;
+  return LL_OK;
+}
+
+enum ll_status ull_append(struct ull_list *list, void *data) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return insert_at(list, list->length, data);
+}
+
+enum ll_status ull_prepend(struct ull_list *list, void *data) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+  return insert_at(list, 0, data);
+}
+
+enum ll_status ull_set(struct ull_list *list, size_t idx, void *data) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+  size_t off;
+  struct ull_node *n = locate(list, idx, &off, NULL);
+  n->data[off] = data;
+  return LL_OK;
+}
+
+enum ll_status ull_insert_after(struct ull_list *list, size_t idx,
+                                void *data) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+  return insert_at(list, idx + 1, data);
+}
+
+enum ll_status ull_delete(struct ull_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return LL_FAIL;
+  }
+
+  size_t off;
+  struct ull_node *p;
+  struct ull_node *n = locate(list, idx, &off, &p);
+
+  n->count--;
+  memmove(&n->data[off], &n->data[off + 1], (n->count - off) * sizeof(void *));
+  list->length--;
+
+  if (n->count == 0) {
+    // Empty node, unlink it
+    if (p == NULL) {
+      list->head = n->next;
+    } else {
+      p->next = n->next;
+    }
+    if (list->tail == n) {
+      list->tail = p;
+    }
+    node_free(list, n);
+    return LL_OK;
+  }
+
+  struct ull_node *next = n->next;
+  if (n->count >= ULL_NODE_CAPACITY / 2 || next == NULL) {
+    return LL_OK;
+  }
+
+  if (n->count + next->count <= ULL_NODE_CAPACITY) {
+    // Merge next into n
+    memcpy(&n->data[n->count], next->data, next->count * sizeof(void *));
+    n->count += next->count;
+    n->next = next->next;
+    if (list->tail == next) {
+      list->tail = n;
+    }
+    node_free(list, next);
+  } else {
+    // Borrow from the front of next to even the two nodes out
+    size_t k = (next->count - n->count) / 2;
+    memcpy(&n->data[n->count], next->data, k * sizeof(void *));
+    memmove(next->data, &next->data[k], (next->count - k) * sizeof(void *));
+    n->count += k;
+    next->count -= k;
+  }
+
+  return LL_OK;
+}
+
+enum ll_status ull_destroy(struct ull_list *list) {
+  if (list == NULL) {
+    return LL_FAIL;
+  }
+
+  if (list->alloc->free_all != NULL) {
+    list->alloc->free_all(list->alloc->ctx);
+  } else {
+    struct ull_node *n = list->head;
+    struct ull_node *t = list->head;
+    while (n != NULL) {
+      t = n;
+      n = n->next;
+      node_free(list, t);
+    }
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+  return LL_OK;
+}
+
+void *ull_get(struct ull_list *list, size_t idx) {
+  if (list == NULL || idx >= list->length) {
+    return NULL;
+  }
+
+  // Elements in the tail node do not need a walk
+  if (idx >= list->length - list->tail->count) {
+    return list->tail->data[idx - (list->length - list->tail->count)];
+  }
+
+  size_t off;
+  struct ull_node *n = locate(list, idx, &off, NULL);
+  return n->data[off];
+}
+
+size_t ull_length(const struct ull_list *list) {
+  if (list == NULL) {
+    return 0;
+  }
+  return list->length;
+}
+
+void ull_iterate(struct ull_list *list,
+                 enum ll_status (*cb)(void *data, void *cookie), void *cookie) {
+  if (list == NULL) {
+    return;
+  }
+  for (struct ull_node *n = list->head; n != NULL; n = n->next) {
+    for (size_t i = 0; i < n->count; i++) {
+      if (cb(n->data[i], cookie) == LL_FAIL) {
+        return;
+      }
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file
+ *
+ * Unrolled linked list. Each node holds a small array of data pointers, so
+ * walking the list touches one node (two cache lines on LP64) per
+ * ULL_NODE_CAPACITY elements instead of one node per element. Positional
+ * functions skip whole nodes by their element count.
+ *
+ * Inserting into a full node splits it in two. Deleting from a node that drops
+ * below half full merges it with, or borrows from, the next node. Appending to
+ * a full tail starts a new node so that lists built by appending stay fully
+ * packed.
+ *
+ * The API mirrors linked_list.h. Since elements are not nodes of their own,
+ * the iteration callback gets the data pointer instead of a node.
+ */
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <stddef.h>
+
+#include "linked_list.h"
+
+// Data pointers per node. With the next pointer and the count this makes a
+// node 128 bytes on LP64.
+#define ULL_NODE_CAPACITY (14)
+
+struct ull_node {
+  struct ull_node *next;
+  size_t count;
+  void *data[ULL_NODE_CAPACITY];
+};
+
+struct ull_list {
+  struct ull_node *head;
+  struct ull_node *tail;
+  size_t length;
+  const struct ll_allocator *alloc;
+};
+
+/**
+ * Initialize @p list to an empty list that allocates its nodes with
+ * ll_default_allocator.
+ */
+enum ll_status ull_init(struct ull_list *list);
+
+/**
+ * Initialize @p list to an empty list that allocates and frees its nodes with
+ * @p alloc. The allocator must outlive the list.
+ */
+enum ll_status ull_init_with_allocator(struct ull_list *list,
+                                       const struct ll_allocator *alloc);
+
+/**
+ * Append @p data to the tail of the list.
+ */
+enum ll_status ull_append(struct ull_list *list, void *data);
+
+/**
+ * Prepend @p data to the head of the list.
+ */
+enum ll_status ull_prepend(struct ull_list *list, void *data);
+
+/**
+ * Set element at index @p idx to @p data.
+ */
+enum ll_status ull_set(struct ull_list *list, size_t idx, void *data);
+
+/**
+ * Insert @p data after the element at index @p idx.
+ */
+enum ll_status ull_insert_after(struct ull_list *list, size_t idx, void *data);
+
+/**
+ * Delete element at index @p idx.
+ */
+enum ll_status ull_delete(struct ull_list *list, size_t idx);
+
+/**
+ * Destroy the whole list and leave @p list empty so that it can be reused.
+ */
+enum ll_status ull_destroy(struct ull_list *list);
+
+/**
+ * @return element at index @p idx.
+ * @return NULL if @p idx is out of range.
+ */
+void *ull_get(struct ull_list *list, size_t idx);
+
+/**
+ * Return number of elements in the list. Does not walk the list.
+ */
+size_t ull_length(const struct ull_list *list);
+
+/**
+ * Iterate over the list calling @p cb function with every element until every
+ * element is visited or until the @p cb function returns LL_FAIL.
+ */
+void ull_iterate(struct ull_list *list,
+                 enum ll_status (*cb)(void *data, void *cookie), void *cookie);
+
+#endif  // UNROLLED_LIST_H
@@ -0,0 +1,192 @@
+#include <string.h>
+
+#include "doubly_linked_list.h"
+#include "unity.h"
+
+#define NUM_STRS (4)
+
+const char *strs[] = {"Red", "Green", "Blue", "Violet"};
+
+struct dll_list list;
+
+void setUp(void) { dll_init(&list); }
+
+void tearDown(void) { dll_destroy(&list); }
+
+/**
+ * Helper test function. Check the list against the strings in @p exp in both
+ * directions, and check that head, tail and length agree with the links.
+ */
+int list_is(struct dll_list *l, const char **exp, size_t n) {
+  struct dll_node *node = l->head;
+  struct dll_node *prev = NULL;
+  for (size_t i = 0; i < n; i++) {
+    if (node == NULL || node->prev != prev || node->data != exp[i]) {
+      return 0;
+    }
+    prev = node;
+    node = node->next;
+  }
+  return node == NULL && l->tail == prev && l->length == n;
+}
+
+void test_dll_init(void) {
+  struct dll_list l;
+  struct ll_allocator no_alloc = ll_default_allocator;
+  no_alloc.alloc = NULL;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, dll_init(NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, dll_init_with_allocator(&l, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, dll_init_with_allocator(&l, &no_alloc));
+  TEST_ASSERT_EQUAL(LL_OK, dll_init(&l));
+  TEST_ASSERT_EQUAL(1, list_is(&l, strs, 0));
+}
+
+void test_dll_append(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, dll_append(NULL, NULL));
+
+  struct dll_node *n = dll_append(&list, (void *)strs[0]);
+  TEST_ASSERT_NOT_NULL(n);
+  TEST_ASSERT_EQUAL_PTR(list.head, n);
+  TEST_ASSERT_NOT_NULL(dll_append(&list, (void *)strs[1]));
+  TEST_ASSERT_NOT_NULL(dll_append(&list, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, strs, 3));
+}
+
+void test_dll_prepend(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, dll_prepend(NULL, NULL));
+
+  struct dll_node *n = dll_prepend(&list, (void *)strs[2]);
+  TEST_ASSERT_EQUAL_PTR(list.tail, n);
+  TEST_ASSERT_NOT_NULL(dll_prepend(&list, (void *)strs[1]));
+  TEST_ASSERT_NOT_NULL(dll_prepend(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, strs, 3));
+}
+
+void test_dll_insert_before(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, dll_insert_before(&list, NULL, NULL));
+
+  struct dll_node *violet = dll_append(&list, (void *)strs[3]);
+  TEST_ASSERT_EQUAL_PTR(NULL, dll_insert_before(NULL, violet, NULL));
+
+  // Before the head, then in the middle
+  struct dll_node *green = dll_insert_before(&list, violet, (void *)strs[1]);
+  TEST_ASSERT_NOT_NULL(dll_insert_before(&list, green, (void *)strs[0]));
+  TEST_ASSERT_NOT_NULL(dll_insert_before(&list, violet, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, strs, 4));
+}
+
+void test_dll_insert_after(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, dll_insert_after(&list, NULL, NULL));
+
+  struct dll_node *red = dll_append(&list, (void *)strs[0]);
+  TEST_ASSERT_EQUAL_PTR(NULL, dll_insert_after(NULL, red, NULL));
+
+  // After the tail, then in the middle
+  struct dll_node *blue = dll_insert_after(&list, red, (void *)strs[2]);
+  TEST_ASSERT_NOT_NULL(dll_insert_after(&list, blue, (void *)strs[3]));
+  TEST_ASSERT_NOT_NULL(dll_insert_after(&list, red, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, strs, 4));
+}
+
+void test_dll_unlink(void) {
+  struct dll_node *nodes[NUM_STRS];
+  const char *exp[] = {strs[1], strs[2]};
+
+  TEST_ASSERT_EQUAL(LL_FAIL, dll_unlink(&list, NULL));
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    nodes[i] = dll_append(&list, (void *)strs[i]);
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, dll_unlink(NULL, nodes[0]));
+
+  // Tail, head, then the middle ones
+  TEST_ASSERT_EQUAL(LL_OK, dll_unlink(&list, nodes[3]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, strs, 3));
+  TEST_ASSERT_EQUAL(LL_OK, dll_unlink(&list, nodes[0]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 2));
+  TEST_ASSERT_EQUAL(LL_OK, dll_unlink(&list, nodes[2]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 1));
+  TEST_ASSERT_EQUAL(LL_OK, dll_unlink(&list, nodes[1]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 0));
+}
+
+void test_dll_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, dll_destroy(NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_NOT_NULL(dll_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, dll_destroy(&list));
+  TEST_ASSERT_EQUAL(1, list_is(&list, strs, 0));
+  TEST_ASSERT_EQUAL(LL_OK, dll_destroy(&list));
+}
+
+void test_dll_length(void) {
+  TEST_ASSERT_EQUAL(0, dll_length(NULL));
+  TEST_ASSERT_EQUAL(0, dll_length(&list));
+
+  struct dll_node *n = dll_append(&list, (void *)strs[0]);
+  dll_insert_after(&list, n, (void *)strs[1]);
+  dll_insert_before(&list, n, (void *)strs[2]);
+  TEST_ASSERT_EQUAL(3, dll_length(&list));
+  dll_unlink(&list, n);
+  TEST_ASSERT_EQUAL(2, dll_length(&list));
+}
+
+/*
+ * Iterator callback that concatenates node strings into the cookie buffer and
+ * stops at "Green".
+ */
+enum ll_status cat_until_green(struct dll_node *node, void *cookie) {
+  strcat((char *)cookie, (char *)node->data);
+  if (strcmp((char *)node->data, "Green") == 0) {
+    return LL_FAIL;
+  }
+  return LL_OK;
+}
+
+void test_dll_iterate(void) {
+  char buf[64] = {0};
+
+  dll_iterate(NULL, cat_until_green, buf);
+  dll_iterate(&list, cat_until_green, buf);
+  TEST_ASSERT_EQUAL_STRING("", buf);
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_NOT_NULL(dll_append(&list, (void *)strs[i]));
+  }
+  dll_iterate(&list, cat_until_green, buf);
+  TEST_ASSERT_EQUAL_STRING("RedGreen", buf);
+}
+
+void test_dll_iterate_reverse(void) {
+  char buf[64] = {0};
+
+  dll_iterate_reverse(NULL, cat_until_green, buf);
+  dll_iterate_reverse(&list, cat_until_green, buf);
+  TEST_ASSERT_EQUAL_STRING("", buf);
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_NOT_NULL(dll_append(&list, (void *)strs[i]));
+  }
+  dll_iterate_reverse(&list, cat_until_green, buf);
+  TEST_ASSERT_EQUAL_STRING("VioletBlueGreen", buf);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_dll_init);
+  RUN_TEST(test_dll_length);
+  RUN_TEST(test_dll_iterate);
+  RUN_TEST(test_dll_iterate_reverse);
+
+  RUN_TEST(test_dll_append);
+  RUN_TEST(test_dll_prepend);
+  RUN_TEST(test_dll_insert_before);
+  RUN_TEST(test_dll_insert_after);
+  RUN_TEST(test_dll_unlink);
+  RUN_TEST(test_dll_destroy);
+
+  return UNITY_END();
+}
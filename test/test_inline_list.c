@@ -0,0 +1,241 @@
+#include <string.h>
+
+#include "inline_list.h"
+#include "ll_pool.h"
+#include "unity.h"
+
+#define NUM_RECS (4)
+
+// Small fixed-size record of the kind the inline list is meant for
+struct rec {
+  int id;
+  double value;
+  char tag[8];
+};
+
+const struct rec recs[NUM_RECS] = {
+    {0, 0.5, "Red"}, {1, 1.5, "Green"}, {2, 2.5, "Blue"}, {3, 3.5, "Violet"}};
+
+struct inl_list list;
+
+void setUp(void) { inl_init(&list, sizeof(struct rec)); }
+
+void tearDown(void) { inl_destroy(&list); }
+
+/**
+ * Helper test function. Check that the list holds copies of the records with
+ * the ids in @p ids, in order, and that tail and length are right.
+ */
+int list_is(struct inl_list *l, const int *ids, size_t n) {
+  struct inl_node *node = l->head;
+  struct inl_node *tail = NULL;
+  for (size_t i = 0; i < n; i++) {
+    if (node == NULL || memcmp(inl_data(node), &recs[ids[i]],
+                               sizeof(struct rec)) != 0) {
+      return 0;
+    }
+    tail = node;
+    node = node->next;
+  }
+  return node == NULL && l->tail == tail && l->length == n;
+}
+
+void test_inl_init(void) {
+  struct inl_list l;
+  struct ll_allocator no_free = ll_default_allocator;
+  no_free.free = NULL;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_init(NULL, sizeof(struct rec)));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_init(&l, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL,
+                    inl_init_with_allocator(&l, sizeof(struct rec), NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL,
+                    inl_init_with_allocator(&l, sizeof(struct rec), &no_free));
+
+  TEST_ASSERT_EQUAL(LL_OK, inl_init(&l, sizeof(struct rec)));
+  TEST_ASSERT_EQUAL(0, inl_length(&l));
+  TEST_ASSERT_EQUAL(sizeof(struct rec), l.elem_size);
+}
+
+void test_inl_append(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_append(NULL, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_append(&list, NULL));
+
+  // Elements are copies, not the caller's records
+  const int exp[] = {0, 1, 2};
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[0]));
+  TEST_ASSERT_TRUE(inl_data(list.head) != (void *)&recs[0]);
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 1));
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[2]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 3));
+}
+
+void test_inl_prepend(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_prepend(NULL, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_prepend(&list, NULL));
+
+  const int exp[] = {0, 1, 2};
+  TEST_ASSERT_EQUAL(LL_OK, inl_prepend(&list, &recs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_prepend(&list, &recs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_prepend(&list, &recs[0]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 3));
+}
+
+void test_inl_insert_after(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_insert_after(NULL, 0, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_insert_after(&list, 0, &recs[0]));
+
+  const int exp[] = {0, 1, 2, 3};
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_insert_after(&list, 0, &recs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_insert_after(&list, 0, &recs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_insert_after(&list, 2, &recs[3]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_insert_after(&list, 4, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_insert_after(&list, 0, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 4));
+}
+
+void test_inl_set(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_set(NULL, 0, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_set(&list, 0, &recs[0]));
+
+  const int exp[] = {3, 2, 1};
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_set(&list, 0, &recs[3]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_set(&list, 1, &recs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, inl_set(&list, 2, &recs[1]));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_set(&list, 3, &recs[1]));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 3));
+}
+
+void test_inl_delete(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_delete(NULL, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_delete(&list, 0));
+
+  for (unsigned int i = 0; i < NUM_RECS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_delete(&list, NUM_RECS));
+
+  // Delete tail, middle, head, last
+  const int exp1[] = {0, 1, 2};
+  const int exp2[] = {0, 2};
+  const int exp3[] = {2};
+  TEST_ASSERT_EQUAL(LL_OK, inl_delete(&list, 3));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp1, 3));
+  TEST_ASSERT_EQUAL(LL_OK, inl_delete(&list, 1));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp2, 2));
+  TEST_ASSERT_EQUAL(LL_OK, inl_delete(&list, 0));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp3, 1));
+  TEST_ASSERT_EQUAL(LL_OK, inl_delete(&list, 0));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp3, 0));
+}
+
+void test_inl_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, inl_destroy(NULL));
+
+  for (unsigned int i = 0; i < NUM_RECS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, inl_destroy(&list));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.head);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.tail);
+  TEST_ASSERT_EQUAL(0, inl_length(&list));
+  TEST_ASSERT_EQUAL(LL_OK, inl_destroy(&list));
+}
+
+void test_inl_get(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, inl_get(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, inl_get(&list, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, inl_data(NULL));
+
+  for (unsigned int i = 0; i < NUM_RECS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[i]));
+  }
+
+  // Pointer goes straight into the node and can be used to modify in place
+  struct rec *r = inl_get(&list, 2);
+  TEST_ASSERT_EQUAL_PTR(list.head->next->next->data, r);
+  TEST_ASSERT_EQUAL_STRING("Blue", r->tag);
+  r->id = 42;
+  TEST_ASSERT_EQUAL(42, ((struct rec *)inl_get(&list, 2))->id);
+  TEST_ASSERT_EQUAL_STRING("Violet", ((struct rec *)inl_get(&list, 3))->tag);
+  TEST_ASSERT_EQUAL_PTR(NULL, inl_get(&list, 4));
+}
+
+void test_inl_length(void) {
+  TEST_ASSERT_EQUAL(0, inl_length(NULL));
+  TEST_ASSERT_EQUAL(0, inl_length(&list));
+  for (unsigned int i = 0; i < NUM_RECS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[i]));
+    TEST_ASSERT_EQUAL(i + 1, inl_length(&list));
+  }
+}
+
+/*
+ * Iterator callback that sums record values and stops at id 2
+ */
+enum ll_status sum_until_2(struct inl_node *node, void *cookie) {
+  struct rec *r = inl_data(node);
+  *(double *)cookie += r->value;
+  return r->id == 2 ? LL_FAIL : LL_OK;
+}
+
+void test_inl_iterate(void) {
+  double sum = 0.0;
+
+  inl_iterate(NULL, sum_until_2, &sum);
+  inl_iterate(&list, sum_until_2, &sum);
+  TEST_ASSERT_EQUAL(0, (int)sum);
+
+  for (unsigned int i = 0; i < NUM_RECS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, inl_append(&list, &recs[i]));
+  }
+  inl_iterate(&list, sum_until_2, &sum);
+  TEST_ASSERT_EQUAL(9, (int)(sum * 2));  // 0.5 + 1.5 + 2.5
+}
+
+void test_inl_with_pool(void) {
+  struct ll_pool pool;
+  struct inl_list l;
+
+  // One pool block per node
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_init(&pool,
+                                        sizeof(struct inl_node) +
+                                            sizeof(struct rec),
+                                        NUM_RECS));
+  TEST_ASSERT_EQUAL(LL_OK, inl_init_with_allocator(&l, sizeof(struct rec),
+                                                   ll_pool_allocator(&pool)));
+  const int exp[] = {0, 1, 2, 3};
+  for (unsigned int i = 0; i < NUM_RECS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, inl_append(&l, &recs[i]));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&l, exp, NUM_RECS));
+  TEST_ASSERT_EQUAL_PTR(NULL, pool.chunks->next);  // Still one chunk
+
+  TEST_ASSERT_EQUAL(LL_OK, inl_destroy(&l));
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_destroy(&pool));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_inl_init);
+  RUN_TEST(test_inl_get);
+  RUN_TEST(test_inl_length);
+  RUN_TEST(test_inl_iterate);
+
+  RUN_TEST(test_inl_append);
+  RUN_TEST(test_inl_prepend);
+  RUN_TEST(test_inl_insert_after);
+  RUN_TEST(test_inl_set);
+  RUN_TEST(test_inl_delete);
+  RUN_TEST(test_inl_destroy);
+
+  RUN_TEST(test_inl_with_pool);
+
+  return UNITY_END();
+}
@@ -0,0 +1,170 @@
+#include <string.h>
+
+#include "intrusive_list.h"
+#include "unity.h"
+
+#define NUM_COLORS (4)
+
+// User struct with the list link embedded in the middle, so that
+// il_container_of has a non-zero offset to undo.
+struct color {
+  const char *name;
+  struct il_node link;
+  unsigned int id;
+};
+
+struct color colors[NUM_COLORS];
+
+struct il_node *head = NULL;
+
+void setUp(void) {
+  const char *names[] = {"Red", "Green", "Blue", "Violet"};
+  for (unsigned int i = 0; i < NUM_COLORS; i++) {
+    colors[i].name = names[i];
+    colors[i].link.next = NULL;
+    colors[i].id = i;
+  }
+  head = NULL;
+}
+
+void tearDown(void) {}
+
+/**
+ * Helper test function. Check that the list holds exactly the colors with the
+ * ids in @p ids, in order.
+ */
+int list_is(struct il_node *h, const unsigned int *ids, unsigned int n) {
+  for (unsigned int i = 0; i < n; i++) {
+    if (h == NULL || il_container_of(h, struct color, link)->id != ids[i]) {
+      return 0;
+    }
+    h = h->next;
+  }
+  return h == NULL;
+}
+
+void test_il_container_of(void) {
+  TEST_ASSERT_EQUAL_PTR(&colors[2],
+                        il_container_of(&colors[2].link, struct color, link));
+  TEST_ASSERT_EQUAL_STRING(
+      "Blue", il_container_of(&colors[2].link, struct color, link)->name);
+}
+
+void test_il_append(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, il_append(NULL, &colors[0].link));
+  TEST_ASSERT_EQUAL(LL_FAIL, il_append(&head, NULL));
+
+  const unsigned int exp[] = {0, 1, 2};
+  TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[0].link));
+  TEST_ASSERT_EQUAL(1, list_is(head, exp, 1));
+  TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[1].link));
+  TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[2].link));
+  TEST_ASSERT_EQUAL(1, list_is(head, exp, 3));
+}
+
+void test_il_prepend(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, il_prepend(NULL, &colors[0].link));
+  TEST_ASSERT_EQUAL(LL_FAIL, il_prepend(&head, NULL));
+
+  const unsigned int exp[] = {0, 1, 2};
+  TEST_ASSERT_EQUAL(LL_OK, il_prepend(&head, &colors[2].link));
+  TEST_ASSERT_EQUAL(LL_OK, il_prepend(&head, &colors[1].link));
+  TEST_ASSERT_EQUAL(LL_OK, il_prepend(&head, &colors[0].link));
+  TEST_ASSERT_EQUAL(1, list_is(head, exp, 3));
+}
+
+void test_il_insert_after(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, il_insert_after(NULL, 0, &colors[0].link));
+
+  // Cannot insert after a non-existent index
+  TEST_ASSERT_EQUAL(LL_FAIL, il_insert_after(&head, 0, &colors[0].link));
+
+  const unsigned int exp[] = {0, 1, 2, 3};
+  TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[0].link));
+  TEST_ASSERT_EQUAL(LL_OK, il_insert_after(&head, 0, &colors[2].link));
+  TEST_ASSERT_EQUAL(LL_OK, il_insert_after(&head, 0, &colors[1].link));
+  TEST_ASSERT_EQUAL(LL_OK, il_insert_after(&head, 2, &colors[3].link));
+  TEST_ASSERT_EQUAL(LL_FAIL, il_insert_after(&head, 4, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(head, exp, 4));
+}
+
+void test_il_delete(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, il_delete(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, il_delete(&head, 0));
+
+  for (unsigned int i = 0; i < NUM_COLORS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[i].link));
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, il_delete(&head, NUM_COLORS));
+
+  // Delete tail, middle, head. The caller gets back the node it owns.
+  const unsigned int exp[] = {0, 2};
+  TEST_ASSERT_EQUAL_PTR(&colors[3].link, il_delete(&head, 3));
+  TEST_ASSERT_EQUAL_PTR(&colors[1].link, il_delete(&head, 1));
+  TEST_ASSERT_EQUAL(1, list_is(head, exp, 2));
+  TEST_ASSERT_EQUAL_PTR(&colors[0].link, il_delete(&head, 0));
+  TEST_ASSERT_EQUAL_PTR(&colors[2].link, il_delete(&head, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+}
+
+void test_il_get(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, il_get(NULL, 0));
+
+  for (unsigned int i = 0; i < NUM_COLORS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[i].link));
+  }
+  TEST_ASSERT_EQUAL_PTR(&colors[0].link, il_get(head, 0));
+  TEST_ASSERT_EQUAL_PTR(&colors[3].link, il_get(head, 3));
+  TEST_ASSERT_EQUAL_PTR(NULL, il_get(head, 4));
+}
+
+void test_il_length(void) {
+  TEST_ASSERT_EQUAL(0, il_length(NULL));
+
+  for (unsigned int i = 0; i < NUM_COLORS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[i].link));
+    TEST_ASSERT_EQUAL(i + 1, il_length(head));
+  }
+}
+
+/*
+ * Iterator callback that concatenates color names into the cookie buffer and
+ * stops at "Blue".
+ */
+enum ll_status cat_until_blue(struct il_node *node, void *cookie) {
+  struct color *c = il_container_of(node, struct color, link);
+  strcat((char *)cookie, c->name);
+  if (strcmp(c->name, "Blue") == 0) {
+    return LL_FAIL;
+  }
+  return LL_OK;
+}
+
+void test_il_iterate(void) {
+  char buf[64] = {0};
+
+  il_iterate(NULL, cat_until_blue, buf);
+  TEST_ASSERT_EQUAL_STRING("", buf);
+
+  for (unsigned int i = 0; i < NUM_COLORS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, il_append(&head, &colors[i].link));
+  }
+  il_iterate(head, cat_until_blue, buf);
+  TEST_ASSERT_EQUAL_STRING("RedGreenBlue", buf);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_il_container_of);
+  RUN_TEST(test_il_get);
+  RUN_TEST(test_il_length);
+  RUN_TEST(test_il_iterate);
+
+  RUN_TEST(test_il_append);
+  RUN_TEST(test_il_prepend);
+  RUN_TEST(test_il_insert_after);
+  RUN_TEST(test_il_delete);
+
+  return UNITY_END();
+}
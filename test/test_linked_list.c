@@ -1,3 +1,6 @@
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "linked_list.h"
@@ -10,6 +13,14 @@
 // check the bounds of strs and exp_list.
 #define NUM_STRS (4)
 
+// First index that does not fit the unsigned int API. Where size_t is no wider
+// than unsigned int this is just an out of range index.
+#if SIZE_MAX > UINT_MAX
+#define BIG_IDX ((size_t)UINT_MAX + 1)
+#else
+#define BIG_IDX ((size_t)UINT_MAX)
+#endif
+
 // String constants that comprize the data in the linked list. I.e. linked lists
 // used in this test suite simply point to these strings for their data.
 const char *strs[] = {"Red", "Green", "Blue", "Violet"};
@@ -21,6 +32,9 @@ struct ll_node exp_list[NUM_STRS];
 // Head for the actual linked list produced by the linked list API
 struct ll_node *head = NULL;
 
+// Handle for the actual linked list produced by the ll_list_* API
+struct ll_list list;
+
 /**
  * Create a linked list by hand. The list is composed of NUM_STRS nodes that use
  * strings in the strs array for data. This list is used by test cases as the
@@ -40,8 +54,9 @@ void setUp(void) {
   exp_list[NUM_STRS - 1].data = (void *)strs[NUM_STRS - 1];
   exp_list[NUM_STRS - 1].next = NULL;
 
-  // Clear the actual link list pointer
+  // Clear the actual link list pointer and handle
   head = NULL;
+  ll_list_init(&list);
 }
 
 /**
@@ -50,6 +65,7 @@ void setUp(void) {
 void tearDown(void) {
   ll_destroy(&head);
   head = NULL;
+  ll_list_destroy(&list);
 }
 
 /**
@@ -87,6 +103,29 @@ int strs_equal(void *s1, void *s2) {
   return (!strcmp(s1, s2));
 }
 
+/**
+ * Helper test function. Check that the cached tail, length and finger of a
+ * list handle agree with the chain of nodes hanging off its head.
+ *
+ * @retval 0 If tail, length or finger are stale.
+ * @retval 1 If tail, length and finger match the list.
+ */
+int list_consistent(struct ll_list *l) {
+  struct ll_node *n = l->head;
+  struct ll_node *tail = NULL;
+  int finger_ok = (l->finger == NULL);
+  size_t len = 0;
+  while (n != NULL) {
+    if (n == l->finger && len == l->finger_idx) {
+      finger_ok = 1;
+    }
+    tail = n;
+    len++;
+    n = n->next;
+  }
+  return (tail == l->tail && len == l->length && finger_ok);
+}
+
 void test_ll_append(void) {
   TEST_ASSERT_EQUAL(LL_FAIL, ll_append(NULL, NULL));  // head cannot be NULL
 
@@ -374,6 +413,1989 @@ void test_ll_iterate(void) {
   TEST_ASSERT_EQUAL(1, cnt);
 }
 
+void test_ll_to_array(void) {
+  void *items[NUM_STRS + 1] = {NULL};
+
+  TEST_ASSERT_EQUAL(0, ll_to_array(exp_list, NULL, NUM_STRS));
+  TEST_ASSERT_EQUAL(0, ll_to_array(NULL, items, NUM_STRS));
+
+  // Buffer shorter than the list
+  TEST_ASSERT_EQUAL(2, ll_to_array(exp_list, items, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[1], items[1]);
+  TEST_ASSERT_EQUAL_PTR(NULL, items[2]);
+
+  // Buffer longer than the list
+  TEST_ASSERT_EQUAL(NUM_STRS, ll_to_array(exp_list, items, NUM_STRS + 1));
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL_PTR(strs[i], items[i]);
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, items[NUM_STRS]);
+}
+
+void test_ll_to_array_alloc(void) {
+  void **items = NULL;
+  size_t n = 1;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_to_array_alloc(exp_list, NULL, &n));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_to_array_alloc(exp_list, &items, NULL));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_to_array_alloc(NULL, &items, &n));
+  TEST_ASSERT_EQUAL_PTR(NULL, items);
+  TEST_ASSERT_EQUAL(0, n);
+
+  // Long enough for the array to be grown a few times
+  for (size_t i = 0; i < 100; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, (void *)(100 - i)));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_to_array_alloc(head, &items, &n));
+  TEST_ASSERT_EQUAL(100, n);
+  for (size_t i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL_PTR((void *)(i + 1), items[i]);
+  }
+  free(items);
+}
+
+void test_ll_set_sz(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_set_sz(NULL, 0, NULL));
+
+  // Must not wrap around to index 0
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_set_sz(exp_list, BIG_IDX, NULL));
+  TEST_ASSERT_EQUAL_PTR(strs[0], exp_list[0].data);
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_set_sz(exp_list, 3, (void *)strs[0]));
+  TEST_ASSERT_EQUAL_PTR(strs[0], exp_list[3].data);
+}
+
+void test_ll_insert_after_sz(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_after_sz(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_after_sz(&head, 0, NULL));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_after_sz(&head, BIG_IDX, NULL));
+  TEST_ASSERT_EQUAL(1, ll_length_sz(head));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_insert_after_sz(&head, 0, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_insert_after_sz(&head, 2, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+}
+
+void test_ll_delete_sz(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_delete_sz(NULL, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_delete_sz(&head, 0));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_delete_sz(&head, BIG_IDX));
+  TEST_ASSERT_EQUAL(NUM_STRS, ll_length_sz(head));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_delete_sz(&head, 1));
+  exp_list[0].next = &exp_list[2];
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+}
+
+/*
+ * Predicate for the remove tests: the string contains the char at cookie
+ */
+int str_has_char(void *data, void *cookie) {
+  return strchr((const char *)data, *(char *)cookie) != NULL;
+}
+
+/*
+ * Predicate for the remove tests: the int has the parity at cookie
+ */
+int int_has_parity(void *data, void *cookie) {
+  return *(int *)data % 2 == *(int *)cookie;
+}
+
+void test_ll_remove_if(void) {
+  char c = 'l';
+
+  TEST_ASSERT_EQUAL(0, ll_remove_if(NULL, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL(0, ll_remove_if(&head, NULL, &c, NULL));
+  TEST_ASSERT_EQUAL(0, ll_remove_if(&head, str_has_char, &c, NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[i]));
+  }
+
+  // Blue and Violet, which is the tail
+  TEST_ASSERT_EQUAL(2, ll_remove_if(&head, str_has_char, &c, NULL));
+  exp_list[1].next = NULL;
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Head
+  c = 'R';
+  TEST_ASSERT_EQUAL(1, ll_remove_if(&head, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[1], head, strs_equal));
+  TEST_ASSERT_EQUAL(0, ll_remove_if(&head, str_has_char, &c, NULL));
+
+  // Everything
+  c = 'e';
+  TEST_ASSERT_EQUAL(1, ll_remove_if(&head, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // free_fn gets the data of every deleted node and only of those
+  for (int i = 0; i < 10; i++) {
+    int *v = malloc(sizeof(*v));
+    TEST_ASSERT_NOT_NULL(v);
+    *v = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, v));
+  }
+  int parity = 0;
+  TEST_ASSERT_EQUAL(5, ll_remove_if(&head, int_has_parity, &parity, free));
+  TEST_ASSERT_EQUAL(5, ll_length_sz(head));
+  for (struct ll_node *n = head; n != NULL; n = n->next) {
+    TEST_ASSERT_EQUAL(1, *(int *)n->data % 2);
+  }
+  parity = 1;
+  TEST_ASSERT_EQUAL(5, ll_remove_if(&head, int_has_parity, &parity, free));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+}
+
+void test_ll_move_if(void) {
+  struct ll_node *dst = NULL;
+  char c = 'l';
+
+  TEST_ASSERT_EQUAL(0, ll_move_if(NULL, str_has_char, &c, &dst));
+  TEST_ASSERT_EQUAL(0, ll_move_if(&head, NULL, &c, &dst));
+  TEST_ASSERT_EQUAL(0, ll_move_if(&head, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL(0, ll_move_if(&head, str_has_char, &c, &head));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[i]));
+  }
+
+  // Blue and Violet, in order, onto an empty list
+  TEST_ASSERT_EQUAL(2, ll_move_if(&head, str_has_char, &c, &dst));
+  exp_list[1].next = NULL;
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[2], dst, strs_equal));
+
+  // Red onto the tail of dst, which cannot be the same list
+  c = 'R';
+  TEST_ASSERT_EQUAL(0, ll_move_if(&dst, str_has_char, &c, &dst));
+  struct ll_node *alias = head;
+  TEST_ASSERT_EQUAL(0, ll_move_if(&head, str_has_char, &c, &alias));
+  TEST_ASSERT_EQUAL(1, ll_move_if(&head, str_has_char, &c, &dst));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[1], head, strs_equal));
+  TEST_ASSERT_EQUAL(3, ll_length_sz(dst));
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_get_sz(dst, 2));
+  ll_destroy(&dst);
+}
+
+void test_ll_get_sz(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_get_sz(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_get_sz(exp_list, BIG_IDX));
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_get_sz(exp_list, 0));
+  TEST_ASSERT_EQUAL_PTR(strs[3], ll_get_sz(exp_list, 3));
+}
+
+void test_ll_length_sz(void) {
+  TEST_ASSERT_EQUAL(0, ll_length_sz(NULL));
+  TEST_ASSERT_EQUAL(NUM_STRS, ll_length_sz(exp_list));
+  exp_list[0].next = NULL;
+  TEST_ASSERT_EQUAL(1, ll_length_sz(exp_list));
+}
+
+void test_ll_append_new(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_append_new(NULL, NULL));
+
+  struct ll_node *n = ll_append_new(&head, (void *)strs[0]);
+  TEST_ASSERT_EQUAL_PTR(head, n);
+  n = ll_append_new(&head, (void *)strs[1]);
+  TEST_ASSERT_EQUAL_PTR(head->next, n);
+  TEST_ASSERT_EQUAL_PTR(strs[1], n->data);
+}
+
+void test_ll_prepend_new(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_prepend_new(NULL, NULL));
+
+  struct ll_node *n = ll_prepend_new(&head, (void *)strs[1]);
+  TEST_ASSERT_EQUAL_PTR(head, n);
+  n = ll_prepend_new(&head, (void *)strs[0]);
+  TEST_ASSERT_EQUAL_PTR(head, n);
+  TEST_ASSERT_EQUAL_PTR(strs[0], n->data);
+}
+
+void test_ll_insert_after_new(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_insert_after_new(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_insert_after_new(&head, 0, NULL));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[2]));
+  struct ll_node *n = ll_insert_after_new(&head, 0, (void *)strs[1]);
+  TEST_ASSERT_EQUAL_PTR(head->next, n);
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_insert_after_new(&head, 3, NULL));
+}
+
+void test_ll_insert_after_node(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_insert_after_node(NULL, NULL));
+
+  // Build the whole list off the node handed back by the previous insert
+  struct ll_node *n = ll_append_new(&head, (void *)strs[0]);
+  for (unsigned int i = 1; i < NUM_STRS; i++) {
+    n = ll_insert_after_node(n, (void *)strs[i]);
+    TEST_ASSERT_NOT_NULL(n);
+  }
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Insert in the middle
+  TEST_ASSERT_NOT_NULL(ll_insert_after_node(head, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(NUM_STRS + 1, ll_length(head));
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_get(head, 1));
+}
+
+/**
+ * Helper test function. Fill @p exp with what applying the @p n @p ops to a
+ * list holding the @p len @p orig items should give, the slow way.
+ */
+void batch_expected(void **orig, size_t len, const struct ll_insert_op *ops,
+                    size_t n, void **exp) {
+  size_t e = 0;
+  for (size_t k = 0; k < len; k++) {
+    exp[e++] = orig[k];
+    for (size_t j = 0; j < n; j++) {
+      if (ops[j].idx == k) {
+        exp[e++] = ops[j].data;
+      }
+    }
+  }
+}
+
+/**
+ * Helper test function. Check that the list at @p h holds exactly the @p n
+ * items in @p exp.
+ */
+int chain_matches(struct ll_node *h, void **exp, size_t n) {
+  for (size_t i = 0; i < n; i++, h = h->next) {
+    if (h == NULL || h->data != exp[i]) {
+      return 0;
+    }
+  }
+  return h == NULL;
+}
+
+void test_ll_insert_batch(void) {
+  enum { LEN = 50, OPS = 80 };
+  static int vals[LEN + OPS];
+  void *orig[LEN];
+  void *exp[LEN + OPS];
+  struct ll_insert_op ops[OPS];
+
+  ops[0].idx = 0;
+  ops[0].data = &vals[0];
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_batch(NULL, ops, 1));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_batch(&head, NULL, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_insert_batch(&head, NULL, 0));
+
+  // Nothing to insert after in an empty list
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_batch(&head, ops, 1));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  for (size_t i = 0; i < LEN; i++) {
+    orig[i] = &vals[i];
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, orig[i]));
+  }
+
+  // Unsorted, repeated indices, the tail, and one index out of range, which
+  // leaves the list as it was
+  srand(28);
+  for (size_t i = 0; i < OPS; i++) {
+    ops[i].idx = (size_t)rand() % LEN;
+    ops[i].data = &vals[LEN + i];
+  }
+  ops[3].idx = LEN - 1;
+  ops[7].idx = ops[5].idx;
+  ops[OPS - 1].idx = LEN;
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_insert_batch(&head, ops, OPS));
+  TEST_ASSERT_EQUAL(1, chain_matches(head, orig, LEN));
+
+  ops[OPS - 1].idx = 0;
+  TEST_ASSERT_EQUAL(LL_OK, ll_insert_batch(&head, ops, OPS));
+  batch_expected(orig, LEN, ops, OPS, exp);
+  TEST_ASSERT_EQUAL(1, chain_matches(head, exp, LEN + OPS));
+}
+
+void test_ll_delete_after_node(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_delete_after_node(NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[i]));
+  }
+
+  // Middle, then tail, then nothing after the tail
+  TEST_ASSERT_EQUAL(LL_OK, ll_delete_after_node(head));
+  exp_list[0].next = &exp_list[2];
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+  TEST_ASSERT_EQUAL(LL_OK, ll_delete_after_node(head->next));
+  exp_list[2].next = NULL;
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_delete_after_node(head->next));
+}
+
+void test_ll_append_array(void) {
+  void *items[NUM_STRS];
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    items[i] = (void *)strs[i];
+  }
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_append_array(NULL, items, NUM_STRS));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_append_array(&head, NULL, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append_array(&head, NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // Onto an empty list, then onto a non-empty one
+  TEST_ASSERT_EQUAL(LL_OK, ll_append_array(&head, items, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append_array(&head, &items[1], NUM_STRS - 1));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Nodes can be deleted one by one like any other
+  TEST_ASSERT_EQUAL(LL_OK, ll_delete(&head, 2));
+  TEST_ASSERT_EQUAL(NUM_STRS - 1, ll_length(head));
+}
+
+void test_ll_from_array(void) {
+  void *items[NUM_STRS];
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    items[i] = (void *)strs[i];
+  }
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_from_array(NULL, items, NUM_STRS));
+  TEST_ASSERT_EQUAL(LL_OK, ll_from_array(&head, items, NUM_STRS));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Would leak the existing nodes
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_from_array(&head, items, NUM_STRS));
+}
+
+void test_ll_concat(void) {
+  struct ll_node *second = NULL;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_concat(NULL, &second));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_concat(&head, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_concat(&head, &head));
+  TEST_ASSERT_EQUAL(LL_OK, ll_concat(&head, &second));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // Onto an empty list
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&second, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&second, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_concat(&head, &second));
+  TEST_ASSERT_EQUAL_PTR(NULL, second);
+
+  // Onto a non-empty list
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&second, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&second, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_concat(&head, &second));
+  TEST_ASSERT_EQUAL_PTR(NULL, second);
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Same list under two names would make a cycle
+  second = head;
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_concat(&head, &second));
+}
+
+void test_ll_splice(void) {
+  struct ll_node *src = NULL;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_splice(NULL, 0, &src, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_splice(&head, 0, NULL, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_splice(&head, 0, &head, 0, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_splice(&head, 0, &src, 0, 0));
+
+  // src: red blue, dst: green white
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&src, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&src, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[3]));
+
+  // Out of range positions and ranges change nothing
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_splice(&head, 3, &src, 0, 1));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_splice(&head, 0, &src, 3, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_splice(&head, 0, &src, 1, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_splice(&head, 0, &src, 2, 0));
+  TEST_ASSERT_EQUAL(2, ll_length(head));
+  TEST_ASSERT_EQUAL(2, ll_length(src));
+
+  // Head of src to head of dst, then tail of src into the middle of dst
+  TEST_ASSERT_EQUAL(LL_OK, ll_splice(&head, 0, &src, 0, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_splice(&head, 2, &src, 0, 1));
+  TEST_ASSERT_EQUAL_PTR(NULL, src);
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Middle range to the tail
+  TEST_ASSERT_EQUAL(LL_OK, ll_splice(&src, 0, &head, 1, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_splice(&head, 2, &src, 0, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_get(head, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_get(head, 3));
+  TEST_ASSERT_EQUAL(4, ll_length(head));
+}
+
+void test_ll_split(void) {
+  struct ll_node *second = NULL;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split(NULL, 0, &second));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split(&head, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split(&head, 0, &head));
+  TEST_ASSERT_EQUAL(LL_OK, ll_split(&head, 0, &second));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split(&head, 1, &second));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split(&head, NUM_STRS + 1, &second));
+
+  // At the end, in the middle and at the start
+  TEST_ASSERT_EQUAL(LL_OK, ll_split(&head, NUM_STRS, &second));
+  TEST_ASSERT_EQUAL_PTR(NULL, second);
+  TEST_ASSERT_EQUAL(LL_OK, ll_split(&head, 2, &second));
+  TEST_ASSERT_EQUAL(2, ll_length(head));
+  TEST_ASSERT_EQUAL(2, ll_length(second));
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_get(head, 1));
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_get(second, 0));
+
+  // second has to be empty
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split(&head, 1, &second));
+  TEST_ASSERT_EQUAL(LL_OK, ll_concat(&head, &second));
+  TEST_ASSERT_EQUAL(LL_OK, ll_split(&head, 0, &second));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], second, strs_equal));
+  ll_destroy(&second);
+}
+
+void test_ll_split_n(void) {
+  struct ll_node *parts[5];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split_n(NULL, parts, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split_n(&head, NULL, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_split_n(&head, parts, 0));
+
+  // 11 nodes into 3 parts of 4, 4 and 3
+  for (size_t i = 0; i < 11; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)i));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_split_n(&head, parts, 3));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+  TEST_ASSERT_EQUAL(4, ll_length(parts[0]));
+  TEST_ASSERT_EQUAL(4, ll_length(parts[1]));
+  TEST_ASSERT_EQUAL(3, ll_length(parts[2]));
+  TEST_ASSERT_EQUAL_PTR((void *)4, ll_get(parts[1], 0));
+  TEST_ASSERT_EQUAL_PTR((void *)10, ll_get(parts[2], 2));
+  for (unsigned int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_concat(&head, &parts[i]));
+  }
+
+  // More parts than nodes
+  TEST_ASSERT_EQUAL(LL_OK, ll_split(&head, 3, &parts[0]));
+  ll_destroy(&parts[0]);
+  TEST_ASSERT_EQUAL(LL_OK, ll_split_n(&head, parts, 5));
+  for (size_t i = 0; i < 5; i++) {
+    TEST_ASSERT_EQUAL(i < 3 ? 1 : 0, ll_length(parts[i]));
+    ll_destroy(&parts[i]);
+  }
+}
+
+void test_ll_reverse(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_reverse(NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_reverse(&head));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // Build with prepend, then put it back in order
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_reverse(&head));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+}
+
+void test_ll_reverse_range(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_reverse_range(NULL, 0, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_reverse_range(&head, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_reverse_range(&head, 0, 1));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_append(&head, (void *)strs[i]));
+  }
+
+  // Ranges past the tail change nothing
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_reverse_range(&head, NUM_STRS + 1, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_reverse_range(&head, 1, NUM_STRS));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_reverse_range(&head, 0, NUM_STRS + 1));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], head, strs_equal));
+
+  // Middle: red blue green white
+  TEST_ASSERT_EQUAL(LL_OK, ll_reverse_range(&head, 1, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_get(head, 1));
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_get(head, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[3], ll_get(head, 3));
+
+  // Tail part, then the whole list from the head: green white blue red
+  TEST_ASSERT_EQUAL(LL_OK, ll_reverse_range(&head, 2, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_reverse_range(&head, 0, 4));
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_get(head, 0));
+  TEST_ASSERT_EQUAL_PTR(strs[3], ll_get(head, 1));
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_get(head, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_get(head, 3));
+  TEST_ASSERT_EQUAL(NUM_STRS, ll_length(head));
+}
+
+/*
+ * Sort test element: sorted by key, seq records the original order
+ */
+struct sort_item {
+  int key;
+  size_t seq;
+};
+
+int sort_item_cmp(void *a, void *b, void *cookie) {
+  // No counting from the threads of the parallel sort
+  if (cookie != NULL) {
+    (*(unsigned int *)cookie)++;
+  }
+  int ka = ((struct sort_item *)a)->key;
+  int kb = ((struct sort_item *)b)->key;
+  return (ka > kb) - (ka < kb);
+}
+
+/**
+ * Helper test function. Check that the list at @p h has @p n items in key
+ * order, with equal keys in their original order.
+ */
+int sorted_stable(struct ll_node *h, size_t n) {
+  struct sort_item *prev = NULL;
+  for (size_t i = 0; i < n; i++, h = h->next) {
+    if (h == NULL) {
+      return 0;
+    }
+    struct sort_item *cur = h->data;
+    if (prev != NULL && (prev->key > cur->key ||
+                         (prev->key == cur->key && prev->seq > cur->seq))) {
+      return 0;
+    }
+    prev = cur;
+  }
+  return h == NULL;
+}
+
+void test_ll_sort(void) {
+  struct sort_item items[200];
+  unsigned int calls = 0;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_sort(NULL, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_sort(&head, NULL, &calls));
+  TEST_ASSERT_EQUAL(LL_OK, ll_sort(&head, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // Random, few distinct keys to exercise stability, every length up to 200
+  srand(20);
+  for (size_t n = 1; n <= 200; n++) {
+    for (size_t i = 0; i < n; i++) {
+      items[i].key = rand() % 8;
+      items[i].seq = i;
+      TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[n - 1 - i]));
+    }
+    TEST_ASSERT_EQUAL(LL_OK, ll_sort(&head, sort_item_cmp, &calls));
+    TEST_ASSERT_EQUAL(1, sorted_stable(head, n));
+    ll_destroy(&head);
+  }
+  TEST_ASSERT_NOT_EQUAL(0, calls);
+
+  // Sorted and reverse sorted
+  for (size_t i = 0; i < 200; i++) {
+    items[i].key = (int)i;
+    items[i].seq = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_sort(&head, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL(1, sorted_stable(head, 200));
+  TEST_ASSERT_EQUAL(LL_OK, ll_sort(&head, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL(1, sorted_stable(head, 200));
+}
+
+void test_ll_sort_parallel(void) {
+  enum { N = 20000 };
+  static struct sort_item items[N];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_sort_parallel(NULL, sort_item_cmp, NULL, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_sort_parallel(&head, NULL, NULL, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_sort_parallel(&head, sort_item_cmp, NULL, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_sort_parallel(&head, sort_item_cmp, NULL, 2));
+
+  // Long enough to be cut into segments, with an odd segment count and more
+  // threads than the list is worth
+  srand(21);
+  for (size_t threads = 1; threads <= 9; threads *= 3) {
+    for (size_t i = 0; i < N; i++) {
+      items[i].key = rand() % 100;
+      items[i].seq = i;
+      TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[N - 1 - i]));
+    }
+    TEST_ASSERT_EQUAL(LL_OK,
+                      ll_sort_parallel(&head, sort_item_cmp, NULL, threads));
+    TEST_ASSERT_EQUAL(1, sorted_stable(head, N));
+    ll_destroy(&head);
+  }
+
+  // Short list sorts on the calling thread
+  for (size_t i = 0; i < 10; i++) {
+    items[i].key = (int)(10 - i);
+    items[i].seq = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_sort_parallel(&head, sort_item_cmp, NULL, 4));
+  TEST_ASSERT_EQUAL(1, sorted_stable(head, 10));
+}
+
+/*
+ * Radix sort key: the sort_item key shifted left by the unsigned int that
+ * the cookie points to, to move it to the high digits
+ */
+uint64_t sort_item_key(void *data, void *cookie) {
+  uint64_t key = (uint64_t)((struct sort_item *)data)->key;
+  return key << *(unsigned int *)cookie;
+}
+
+void test_ll_radix_sort(void) {
+  struct sort_item items[300];
+  unsigned int shift = 0;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_radix_sort(NULL, sort_item_key, &shift));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_radix_sort(&head, NULL, &shift));
+  TEST_ASSERT_EQUAL(LL_OK, ll_radix_sort(&head, sort_item_key, &shift));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // Few distinct keys for stability, wide keys spanning several digits, and
+  // keys moved up so the low digits are all zero and get skipped
+  srand(23);
+  for (shift = 0; shift <= 33; shift += 11) {
+    for (size_t n = 1; n <= 300; n += 37) {
+      for (size_t i = 0; i < n; i++) {
+        items[i].key = (i % 2 == 0) ? rand() % 8 : rand();
+        items[i].seq = i;
+        TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[n - 1 - i]));
+      }
+      TEST_ASSERT_EQUAL(LL_OK, ll_radix_sort(&head, sort_item_key, &shift));
+      TEST_ASSERT_EQUAL(1, sorted_stable(head, n));
+      ll_destroy(&head);
+    }
+  }
+
+  // All keys equal: order is kept
+  shift = 0;
+  for (size_t i = 0; i < 50; i++) {
+    items[i].key = 12345;
+    items[i].seq = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[49 - i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_radix_sort(&head, sort_item_key, &shift));
+  TEST_ASSERT_EQUAL(1, sorted_stable(head, 50));
+}
+
+void test_ll_merge(void) {
+  struct sort_item items[60];
+  struct ll_node *src = NULL;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge(NULL, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge(&head, NULL, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge(&head, &head, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge(&head, &src, NULL, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_merge(&head, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+
+  // Two sorted lists with shared keys, the ones in dst come first
+  srand(25);
+  int key = 0;
+  for (size_t i = 0; i < 60; i++) {
+    if (i == 30) {
+      key = 0;
+    }
+    key += rand() % 3;
+    items[i].key = key;
+    items[i].seq = i;
+  }
+  for (size_t i = 30; i-- > 0;) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&head, &items[i]));
+    TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&src, &items[30 + i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge(&head, &head, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_merge(&head, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, src);
+  TEST_ASSERT_EQUAL(1, sorted_stable(head, 60));
+
+  // Into an empty list
+  TEST_ASSERT_EQUAL(LL_OK, ll_merge(&src, &head, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, head);
+  TEST_ASSERT_EQUAL(1, sorted_stable(src, 60));
+  ll_destroy(&src);
+}
+
+void test_ll_merge_k(void) {
+  enum { K = 9, MAX_LEN = 30 };
+  struct sort_item items[K * MAX_LEN];
+  struct ll_node *lists[K];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge_k(NULL, 1, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_merge_k(lists, 1, NULL, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_merge_k(lists, 0, sort_item_cmp, NULL));
+
+  // Every list count up to K, including empty lists
+  srand(26);
+  for (size_t k = 1; k <= K; k++) {
+    size_t n = 0;
+    for (size_t l = 0; l < k; l++) {
+      size_t len = (size_t)rand() % (MAX_LEN + 1);
+      int key = 0;
+      lists[l] = NULL;
+      for (size_t i = 0; i < len; i++) {
+        key += rand() % 4;
+        items[n + i].key = key;
+        items[n + i].seq = n + i;
+      }
+      for (size_t i = len; i-- > 0;) {
+        TEST_ASSERT_EQUAL(LL_OK, ll_prepend(&lists[l], &items[n + i]));
+      }
+      n += len;
+    }
+    TEST_ASSERT_EQUAL(LL_OK, ll_merge_k(lists, k, sort_item_cmp, NULL));
+    for (size_t l = 1; l < k; l++) {
+      TEST_ASSERT_EQUAL_PTR(NULL, lists[l]);
+    }
+    TEST_ASSERT_EQUAL(1, sorted_stable(lists[0], n));
+    ll_destroy(&lists[0]);
+  }
+}
+
+void test_ll_list_append(void) {
+  // list cannot be NULL
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_append(NULL, NULL));
+
+  // Append to an empty list
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL_PTR(list.head, list.tail);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  // Append the rest and compare to the expected list
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_list_prepend(void) {
+  // list cannot be NULL
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_prepend(NULL, NULL));
+
+  // Prepend to an empty list sets the tail too
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[3]));
+  TEST_ASSERT_EQUAL_PTR(list.head, list.tail);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_list_insert_after(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_after(NULL, 0, NULL));
+
+  // Cannot insert after a non-existent index
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_after(&list, 0, NULL));
+
+  // Insert after the only node. Tail has to move.
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 0, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  // Insert between nodes
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 0, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  // Insert at the tail end and past the end of the list
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 2, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_after(&list, 4, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_list_delete(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_delete(NULL, 0));  // list cannot be NULL
+
+  // Delete from an empty list should fail
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_delete(&list, 0));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+
+  // Out of range
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_delete(&list, NUM_STRS));
+
+  // Delete tail. Tail has to move back.
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 3));
+  exp_list[2].next = NULL;
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // Delete middle
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 1));
+  exp_list[0].next = &exp_list[2];
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // Delete head, then the last remaining node
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 0));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.head);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.tail);
+  TEST_ASSERT_EQUAL(0, list.length);
+
+  // The list is still usable after becoming empty
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+}
+
+void test_ll_list_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_destroy(NULL));  // list cannot be NULL
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.head);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.tail);
+  TEST_ASSERT_EQUAL(0, list.length);
+
+  // Two (inadvertent) destroys in a row
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+}
+
+void test_ll_list_length(void) {
+  TEST_ASSERT_EQUAL(0, ll_list_length(NULL));
+  TEST_ASSERT_EQUAL(0, ll_list_length(&list));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 0, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(3, ll_list_length(&list));
+  TEST_ASSERT_EQUAL(ll_length(list.head), ll_list_length(&list));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 1));
+  TEST_ASSERT_EQUAL(2, ll_list_length(&list));
+}
+
+/*
+ * Allocator bookkeeping for the counting allocator below
+ */
+struct alloc_counts {
+  unsigned int allocs;
+  unsigned int frees;
+};
+
+void *counting_alloc(void *ctx, size_t size) {
+  ((struct alloc_counts *)ctx)->allocs++;
+  return malloc(size);
+}
+
+void counting_free(void *ctx, void *ptr) {
+  ((struct alloc_counts *)ctx)->frees++;
+  free(ptr);
+}
+
+void test_ll_list_init_with_allocator(void) {
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+  struct ll_allocator incomplete = {counting_alloc, NULL, &counts, NULL};
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_init_with_allocator(NULL, &counting));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_init_with_allocator(&list, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_init_with_allocator(&list, &incomplete));
+
+  // Every node creating function goes through the allocator
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 1, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 1, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(4, counts.allocs);
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // ... and so does every node freeing function
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 2));
+  TEST_ASSERT_EQUAL(1, counts.frees);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL(4, counts.frees);
+
+  // Default allocator is malloc/free
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init(&list));
+  TEST_ASSERT_EQUAL_PTR(&ll_default_allocator, list.alloc);
+}
+
+void test_ll_list_set(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_set(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_set(&list, 0, NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, NULL));
+  }
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_set(&list, i, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_set(&list, NUM_STRS, NULL));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_list_get(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_get(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_get(&list, 0));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_list_get(&list, 2));
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_list_get(&list, 0));
+  TEST_ASSERT_EQUAL_PTR(strs[3], ll_list_get(&list, 3));
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_list_get(&list, 1));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_get(&list, NUM_STRS));
+}
+
+void test_ll_list_finger(void) {
+  const char *exp[64];
+  size_t n = 0;
+
+  // Ascending access walks from the finger every time after the first
+  for (unsigned int i = 0; i < 32; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i % 4]));
+  }
+  for (unsigned int i = 0; i < 31; i++) {
+    TEST_ASSERT_EQUAL_PTR(strs[i % 4], ll_list_get(&list, i));
+  }
+  TEST_ASSERT_EQUAL(1, list.finger_misses);
+  TEST_ASSERT_EQUAL(30, list.finger_hits);
+
+  // Going backwards restarts from the head
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_list_get(&list, 5));
+  TEST_ASSERT_EQUAL(2, list.finger_misses);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.finger);
+
+  // Random mix of every list changing function. The finger has to stay on
+  // the node at its index and reads through it have to be right.
+  srand(4);
+  for (unsigned int round = 0; round < 2000; round++) {
+    int op = rand() % 6;
+    size_t idx = n == 0 ? 0 : (size_t)rand() % n;
+    const char *d = strs[rand() % 4];
+    if (op == 0 && n < 64) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)d));
+      for (size_t i = n; i > 0; i--) {
+        exp[i] = exp[i - 1];
+      }
+      exp[0] = d;
+      n++;
+    } else if (op == 1 && n > 0 && n < 64) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, idx, (void *)d));
+      for (size_t i = n; i > idx + 1; i--) {
+        exp[i] = exp[i - 1];
+      }
+      exp[idx + 1] = d;
+      n++;
+    } else if (op == 2 && n > 0) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, idx));
+      n--;
+      for (size_t i = idx; i < n; i++) {
+        exp[i] = exp[i + 1];
+      }
+    } else if (op == 3 && n > 0) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_set(&list, idx, (void *)d));
+      exp[idx] = d;
+    } else if (op == 4 && n < 64) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)d));
+      exp[n++] = d;
+    } else if (n > 0) {
+      TEST_ASSERT_EQUAL_PTR(exp[idx], ll_list_get(&list, idx));
+    }
+    TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  }
+  for (size_t i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL_PTR(exp[i], ll_list_get(&list, i));
+  }
+}
+
+void test_ll_list_append_new(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_append_new(NULL, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_prepend_new(NULL, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_insert_after_new(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_insert_after_new(&list, 0, NULL));
+
+  struct ll_node *n = ll_list_append_new(&list, (void *)strs[2]);
+  TEST_ASSERT_EQUAL_PTR(list.tail, n);
+  n = ll_list_prepend_new(&list, (void *)strs[0]);
+  TEST_ASSERT_EQUAL_PTR(list.head, n);
+  n = ll_list_insert_after_new(&list, 0, (void *)strs[1]);
+  TEST_ASSERT_EQUAL_PTR(list.head->next, n);
+  n = ll_list_insert_after_new(&list, 2, (void *)strs[3]);
+  TEST_ASSERT_EQUAL_PTR(list.tail, n);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_list_insert_after_node(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_insert_after_node(&list, NULL, NULL));
+
+  struct ll_node *n = ll_list_append_new(&list, (void *)strs[0]);
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_list_insert_after_node(NULL, n, NULL));
+
+  // After the tail moves the tail
+  struct ll_node *blue = ll_list_insert_after_node(&list, n, (void *)strs[2]);
+  TEST_ASSERT_EQUAL_PTR(list.tail, blue);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  // Before the finger drops the finger
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_list_get(&list, 1));
+  TEST_ASSERT_NOT_NULL(ll_list_insert_after_node(&list, n, (void *)strs[1]));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.finger);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // After the finger keeps it
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_list_get(&list, 1));
+  TEST_ASSERT_NOT_NULL(ll_list_insert_after_node(&list, list.finger, NULL));
+  TEST_ASSERT_NOT_NULL(list.finger);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+}
+
+void test_ll_list_insert_batch(void) {
+  enum { LEN = 40, OPS = 80 };
+  static int vals[LEN + OPS];
+  void *orig[LEN];
+  void *exp[LEN + OPS];
+  struct ll_insert_op ops[OPS];
+  struct ll_list counted;
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+
+  ops[0].idx = 0;
+  ops[0].data = &vals[0];
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_batch(NULL, ops, 1));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_batch(&list, NULL, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_batch(&list, NULL, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_batch(&list, ops, 1));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&counted, &counting));
+  for (size_t i = 0; i < LEN; i++) {
+    orig[i] = &vals[i];
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&counted, orig[i]));
+  }
+  srand(29);
+  for (size_t i = 0; i < OPS; i++) {
+    ops[i].idx = (size_t)rand() % LEN;
+    ops[i].data = &vals[LEN + i];
+  }
+  ops[0].idx = LEN - 1;
+  ops[OPS - 1].idx = LEN;
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_insert_batch(&counted, ops, OPS));
+  TEST_ASSERT_EQUAL(1, list_consistent(&counted));
+  TEST_ASSERT_EQUAL(1, chain_matches(counted.head, orig, LEN));
+
+  // One block, plus the block record, for the whole batch. The finger is
+  // kept and still points at the node its index says.
+  ops[OPS - 1].idx = LEN / 2;
+  ll_list_get(&counted, LEN / 2);
+  counts.allocs = 0;
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_batch(&counted, ops, OPS));
+  TEST_ASSERT_EQUAL(2, counts.allocs);
+  TEST_ASSERT_EQUAL(1, list_consistent(&counted));
+  TEST_ASSERT_NOT_NULL(counted.finger);
+  batch_expected(orig, LEN, ops, OPS, exp);
+  TEST_ASSERT_EQUAL_PTR(exp[LEN + OPS - 1], counted.tail->data);
+  TEST_ASSERT_EQUAL(1, chain_matches(counted.head, exp, LEN + OPS));
+
+  // A small batch allocates its nodes one by one, without a block
+  counts.allocs = 0;
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_batch(&counted, ops, 3));
+  TEST_ASSERT_EQUAL(3, counts.allocs);
+  TEST_ASSERT_EQUAL(1, list_consistent(&counted));
+  TEST_ASSERT_EQUAL(LEN + OPS + 3, counted.length);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&counted));
+  TEST_ASSERT_EQUAL(counts.allocs + 2 + LEN, counts.frees);
+}
+
+void test_ll_list_delete_after_node(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_delete_after_node(&list, NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_delete_after_node(NULL, list.head));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_delete_after_node(&list, list.tail));
+
+  // Delete the tail. Finger on the tail goes away.
+  TEST_ASSERT_EQUAL_PTR(strs[3], ll_list_get(&list, 3));
+  struct ll_node *blue = list.head->next->next;
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete_after_node(&list, blue));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.finger);
+  exp_list[2].next = NULL;
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // Delete right after the finger keeps the finger
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_list_get(&list, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete_after_node(&list, list.head));
+  TEST_ASSERT_NOT_NULL(list.finger);
+  exp_list[0].next = &exp_list[2];
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_list_remove_if(void) {
+  void *ptrs[NUM_STRS];
+  char c = 'l';
+
+  TEST_ASSERT_EQUAL(0, ll_list_remove_if(NULL, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL(0, ll_list_remove_if(&list, NULL, &c, NULL));
+  TEST_ASSERT_EQUAL(0, ll_list_remove_if(&list, str_has_char, &c, NULL));
+
+  // Nodes from a block
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    ptrs[i] = (void *)strs[i];
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, ptrs, NUM_STRS));
+  ll_list_get(&list, 3);
+  TEST_ASSERT_EQUAL(2, ll_list_remove_if(&list, str_has_char, &c, NULL));
+  exp_list[1].next = NULL;
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_list_get(&list, 1));
+
+  // Nodes of their own, then everything
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[2]));
+  c = 'e';
+  TEST_ASSERT_EQUAL(3, ll_list_remove_if(&list, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(0, list.length);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+
+  // free_fn
+  for (int i = 0; i < 10; i++) {
+    int *v = malloc(sizeof(*v));
+    TEST_ASSERT_NOT_NULL(v);
+    *v = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, v));
+  }
+  int parity = 0;
+  TEST_ASSERT_EQUAL(5, ll_list_remove_if(&list, int_has_parity, &parity, free));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(9, *(int *)list.tail->data);
+  parity = 1;
+  TEST_ASSERT_EQUAL(5, ll_list_remove_if(&list, int_has_parity, &parity, free));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+}
+
+void test_ll_list_move_if(void) {
+  void *ptrs[NUM_STRS];
+  struct ll_list dst;
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+  char c = 'l';
+
+  ll_list_init(&dst);
+  TEST_ASSERT_EQUAL(0, ll_list_move_if(NULL, str_has_char, &c, &dst));
+  TEST_ASSERT_EQUAL(0, ll_list_move_if(&list, NULL, &c, &dst));
+  TEST_ASSERT_EQUAL(0, ll_list_move_if(&list, str_has_char, &c, NULL));
+  TEST_ASSERT_EQUAL(0, ll_list_move_if(&list, str_has_char, &c, &list));
+
+  // Block nodes move to dst, which then has to free them
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    ptrs[i] = (void *)strs[i];
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, ptrs, NUM_STRS));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&dst, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(2, ll_list_move_if(&list, str_has_char, &c, &dst));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&dst));
+  TEST_ASSERT_EQUAL(2, list.length);
+  TEST_ASSERT_EQUAL(3, dst.length);
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_list_get(&dst, 1));
+  TEST_ASSERT_EQUAL_PTR(strs[3], dst.tail->data);
+
+  // Moving everything lets go of the block, so list holds no memory
+  c = 'e';
+  TEST_ASSERT_EQUAL(2, ll_list_move_if(&list, str_has_char, &c, &dst));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+
+  // Different allocators cannot share nodes
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(0, ll_list_move_if(&list, str_has_char, &c, &dst));
+  TEST_ASSERT_EQUAL(1, list.length);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&dst));
+}
+
+void test_ll_list_append_array(void) {
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+  void *items[NUM_STRS];
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    items[i] = (void *)strs[i];
+  }
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_append_array(NULL, items, NUM_STRS));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_append_array(&list, NULL, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, NULL, 0));
+  TEST_ASSERT_EQUAL(0, list.length);
+
+  // One allocation for the whole array, spliced after existing nodes. The
+  // first array also allocates the list's block records.
+  ll_list_destroy(&list);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, &items[1], 3));
+  TEST_ASSERT_EQUAL(3, counts.allocs);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // The block is freed with its last node, other nodes as usual
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 0));
+  TEST_ASSERT_EQUAL(1, counts.frees);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 1));
+  TEST_ASSERT_EQUAL(1, counts.frees);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 0));
+
+  // Deleting the last node lets go of the block records too, so the empty
+  // handle can be re-initialized without ll_list_destroy
+  TEST_ASSERT_EQUAL(3, counts.frees);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+
+  // Nodes inserted between block nodes and destroy
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, items, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, &items[2], 2));
+  TEST_ASSERT_EQUAL(6, counts.allocs);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_insert_after(&list, 0, NULL));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+}
+
+/*
+ * Allocator that, like ll_pool, hands out nothing larger than a node
+ */
+void *node_only_alloc(void *ctx, size_t size) {
+  return size > sizeof(struct ll_node) ? NULL : counting_alloc(ctx, size);
+}
+
+void test_ll_list_append_array_fallback(void) {
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator node_only = {node_only_alloc, counting_free, &counts,
+                                   NULL};
+  void *items[NUM_STRS];
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    items[i] = (void *)strs[i];
+  }
+
+  ll_list_destroy(&list);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &node_only));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, items, NUM_STRS));
+  TEST_ASSERT_EQUAL(NUM_STRS, counts.allocs);
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL(NUM_STRS, counts.frees);
+}
+
+void test_ll_list_append_array_many(void) {
+  enum { VALS = 5 };
+  static int vals[VALS] = {0, 1, 2, 3, 4};
+  void *items[VALS];
+  struct ll_list other;
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+  for (unsigned int i = 0; i < VALS; i++) {
+    items[i] = &vals[i];
+  }
+
+  // Many small blocks, with single nodes in between, in two lists
+  ll_list_destroy(&list);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&other, &counting));
+  srand(30);
+  for (size_t i = 0; i < 600; i++) {
+    struct ll_list *l = i % 3 == 0 ? &other : &list;
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(l, items, 1 + i % VALS));
+    if (i % 7 == 0) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_append(l, &vals[0]));
+    }
+  }
+
+  // Nodes of both sets end up in both lists
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&list, 3, &other, 10, 50));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&other, 0, &list, 100, 50));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&other));
+
+  for (size_t i = 0; i < 300; i++) {
+    TEST_ASSERT_EQUAL(LL_OK,
+                      ll_list_delete(&list, (size_t)rand() % list.length));
+  }
+  int parity = 0;
+  TEST_ASSERT_NOT_EQUAL(0, ll_list_remove_if(&other, int_has_parity, &parity,
+                                             NULL));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&other));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&other));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+}
+
+void test_ll_list_from_array(void) {
+  void *items[NUM_STRS];
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    items[i] = (void *)strs[i];
+  }
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_from_array(NULL, items, NUM_STRS));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_from_array(&list, NULL, 1));
+  TEST_ASSERT_EQUAL(0, list.length);
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_from_array(&list, items, NUM_STRS));
+  TEST_ASSERT_EQUAL_PTR(&ll_default_allocator, list.alloc);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_list_get(&list, 2));
+}
+
+void test_ll_list_to_array_alloc(void) {
+  void **items = (void **)&items;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_to_array_alloc(NULL, &items));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_to_array_alloc(&list, NULL));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_to_array_alloc(&list, &items));
+  TEST_ASSERT_EQUAL_PTR(NULL, items);
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_to_array_alloc(&list, &items));
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL_PTR(strs[i], items[i]);
+  }
+  free(items);
+}
+
+void test_ll_list_concat(void) {
+  struct ll_list src;
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+
+  ll_list_init(&src);
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_concat(NULL, &src));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_concat(&list, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_concat(&list, &list));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_concat(&list, &src));
+  TEST_ASSERT_EQUAL(0, list.length);
+
+  // Onto an empty list, then onto a non-empty one
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_concat(&list, &src));
+  TEST_ASSERT_EQUAL(1, list_consistent(&src));
+  TEST_ASSERT_EQUAL(0, src.length);
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_list_get(&list, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_concat(&list, &src));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&src));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // Emptied src lets go of the block it shared, so it can just be dropped
+  void *items[2] = {(void *)strs[0], (void *)strs[1]};
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_from_array(&src, items, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_concat(&list, &src));
+  TEST_ASSERT_EQUAL_PTR(NULL, src.blocks);
+
+  // Different allocators cannot share nodes
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&src, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_concat(&list, &src));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&src));
+}
+
+void test_ll_list_splice(void) {
+  struct ll_list src;
+
+  ll_list_init(&src);
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_splice(NULL, 0, &src, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_splice(&list, 0, NULL, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_splice(&list, 0, &list, 0, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&list, 0, &src, 0, 0));
+
+  // src: red blue, list: green white
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_splice(&list, 3, &src, 0, 1));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_splice(&list, 0, &src, 3, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_splice(&list, 0, &src, 1, 2));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&list, 0, &src, 0, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&list, 2, &src, 0, 1));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&src));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&src));
+
+  // Taking the last nodes of src lets go of its block, so src can be dropped
+  void *items[2] = {(void *)strs[0], (void *)strs[1]};
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_from_array(&src, items, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&list, 0, &src, 0, 1));
+  TEST_ASSERT_NOT_NULL(src.blocks);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&list, 0, &src, 0, 1));
+  TEST_ASSERT_EQUAL_PTR(NULL, src.blocks);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+}
+
+/**
+ * Random appends, array appends, deletes, splices and concatenations across a
+ * few lists, checked against plain arrays. Nodes from the same array block
+ * end up spread over all lists, and every block has to be freed exactly once.
+ */
+void test_ll_list_splice_blocks(void) {
+  enum { LISTS = 3, MAX = 64 };
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+  struct ll_list l[LISTS];
+  size_t exp[LISTS][MAX];
+  size_t n[LISTS] = {0};
+  size_t next_id = 1;
+
+  for (unsigned int i = 0; i < LISTS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&l[i], &counting));
+  }
+  srand(17);
+  for (unsigned int round = 0; round < 3000; round++) {
+    int op = rand() % 5;
+    unsigned int a = (unsigned int)rand() % LISTS;
+    unsigned int b = (unsigned int)rand() % LISTS;
+    if (op == 0 && n[a] < MAX) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&l[a], (void *)next_id));
+      exp[a][n[a]++] = next_id++;
+    } else if (op == 1 && n[a] + 8 <= MAX) {
+      void *items[8];
+      size_t k = 1 + (size_t)rand() % 8;
+      for (size_t i = 0; i < k; i++) {
+        items[i] = (void *)next_id;
+        exp[a][n[a]++] = next_id++;
+      }
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&l[a], items, k));
+    } else if (op == 2 && n[a] > 0) {
+      size_t idx = (size_t)rand() % n[a];
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&l[a], idx));
+      n[a]--;
+      for (size_t i = idx; i < n[a]; i++) {
+        exp[a][i] = exp[a][i + 1];
+      }
+    } else if (op == 3 && a != b && n[a] > 0) {
+      size_t from = (size_t)rand() % n[a];
+      size_t count = (size_t)rand() % (n[a] - from + 1);
+      size_t pos = (size_t)rand() % (n[b] + 1);
+      if (n[b] + count > MAX) {
+        continue;
+      }
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_splice(&l[b], pos, &l[a], from, count));
+      for (size_t i = n[b]; i > pos; i--) {
+        exp[b][i - 1 + count] = exp[b][i - 1];
+      }
+      for (size_t i = 0; i < count; i++) {
+        exp[b][pos + i] = exp[a][from + i];
+      }
+      n[b] += count;
+      n[a] -= count;
+      for (size_t i = from; i < n[a]; i++) {
+        exp[a][i] = exp[a][i + count];
+      }
+    } else if (op == 4 && a != b && n[a] + n[b] <= MAX) {
+      TEST_ASSERT_EQUAL(LL_OK, ll_list_concat(&l[a], &l[b]));
+      for (size_t i = 0; i < n[b]; i++) {
+        exp[a][n[a]++] = exp[b][i];
+      }
+      n[b] = 0;
+    }
+    for (unsigned int i = 0; i < LISTS; i++) {
+      TEST_ASSERT_EQUAL(1, list_consistent(&l[i]));
+      TEST_ASSERT_EQUAL(n[i], l[i].length);
+    }
+  }
+  for (unsigned int i = 0; i < LISTS; i++) {
+    for (size_t j = 0; j < n[i]; j++) {
+      TEST_ASSERT_EQUAL_PTR((void *)exp[i][j], ll_list_get(&l[i], j));
+    }
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&l[i]));
+  }
+  TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+}
+
+void test_ll_list_split(void) {
+  struct ll_list second;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split(NULL, 0, &second));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split(&list, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split(&list, 0, &list));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split(&list, 1, &second));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+
+  // In the middle
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_split(&list, 1, &second));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&second));
+  TEST_ASSERT_EQUAL(1, list.length);
+  TEST_ASSERT_EQUAL(3, second.length);
+  TEST_ASSERT_EQUAL_PTR(strs[1], ll_list_get(&second, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_concat(&list, &second));
+
+  // At the end and at the start
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_split(&list, NUM_STRS, &second));
+  TEST_ASSERT_EQUAL(0, second.length);
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_list_get(&list, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_split(&list, 0, &second));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&second));
+  TEST_ASSERT_EQUAL(0, list.length);
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], second.head, strs_equal));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&second));
+
+  // Splitting off everything lets go of the block, list holds no memory
+  void *items[2] = {(void *)strs[0], (void *)strs[1]};
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_from_array(&list, items, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_split(&list, 0, &second));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+
+  // A second emptied by deletes holds no memory either and can be reused
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&second, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&second, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_from_array(&list, items, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_split(&list, 1, &second));
+  TEST_ASSERT_EQUAL(1, list_consistent(&second));
+  TEST_ASSERT_EQUAL_PTR(strs[1], second.head->data);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&second));
+}
+
+void test_ll_list_split_n(void) {
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+  struct ll_list parts[4];
+  void *items[10];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split_n(NULL, parts, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split_n(&list, NULL, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split_n(&list, parts, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_split_n(&list, &list, 1));
+
+  // Array nodes spread over the parts are each freed once
+  for (size_t i = 0; i < 10; i++) {
+    items[i] = (void *)i;
+  }
+  ll_list_destroy(&list);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&list, items, 10));
+  unsigned int allocs = counts.allocs;
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_split_n(&list, parts, 4));
+  TEST_ASSERT_EQUAL(allocs, counts.allocs);
+  TEST_ASSERT_EQUAL(0, list.length);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.blocks);
+  size_t next = 0;
+  for (size_t p = 0; p < 4; p++) {
+    TEST_ASSERT_EQUAL(1, list_consistent(&parts[p]));
+    TEST_ASSERT_EQUAL(p < 2 ? 3 : 2, parts[p].length);
+    for (size_t i = 0; i < parts[p].length; i++) {
+      TEST_ASSERT_EQUAL_PTR((void *)next++, ll_list_get(&parts[p], i));
+    }
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  for (size_t p = 0; p < 4; p++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&parts[p]));
+  }
+  TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+}
+
+void test_ll_list_reverse(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_reverse(NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_reverse(&list));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_prepend(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL_PTR(strs[2], ll_list_get(&list, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_reverse(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // Finger moved with its node
+  TEST_ASSERT_EQUAL(2, list.finger_idx);
+}
+
+void test_ll_list_reverse_range(void) {
+  size_t exp[32];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_reverse_range(NULL, 0, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_reverse_range(&list, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_reverse_range(&list, 0, 1));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_reverse_range(&list, 1, 0));
+
+  for (size_t i = 0; i < 32; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)i));
+    exp[i] = i;
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_reverse_range(&list, 30, 3));
+
+  // Random ranges against an array, with the finger left all over the place
+  srand(19);
+  for (unsigned int round = 0; round < 500; round++) {
+    size_t from = (size_t)rand() % 33;
+    size_t count = (size_t)rand() % (33 - from);
+    ll_list_get(&list, (size_t)rand() % 32);
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_reverse_range(&list, from, count));
+    for (size_t i = 0; i < count / 2; i++) {
+      size_t t = exp[from + i];
+      exp[from + i] = exp[from + count - 1 - i];
+      exp[from + count - 1 - i] = t;
+    }
+    TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  }
+  for (size_t i = 0; i < 32; i++) {
+    TEST_ASSERT_EQUAL_PTR((void *)exp[i], ll_list_get(&list, i));
+  }
+}
+
+void test_ll_list_sort(void) {
+  struct sort_item items[100];
+  unsigned int calls = 0;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_sort(NULL, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_sort(&list, NULL, &calls));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_sort(&list, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  srand(21);
+  for (size_t i = 0; i < 100; i++) {
+    items[i].key = rand() % 10;
+    items[i].seq = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, &items[i]));
+  }
+  ll_list_get(&list, 50);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_sort(&list, sort_item_cmp, &calls));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, sorted_stable(list.head, 100));
+  TEST_ASSERT_EQUAL(9, ((struct sort_item *)list.tail->data)->key);
+}
+
+void test_ll_list_sort_parallel(void) {
+  enum { N = 10000 };
+  static struct sort_item items[N];
+
+  TEST_ASSERT_EQUAL(LL_FAIL,
+                    ll_list_sort_parallel(NULL, sort_item_cmp, NULL, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_sort_parallel(&list, NULL, NULL, 2));
+  TEST_ASSERT_EQUAL(LL_FAIL,
+                    ll_list_sort_parallel(&list, sort_item_cmp, NULL, 0));
+
+  srand(22);
+  for (size_t i = 0; i < N; i++) {
+    items[i].key = rand() % 100;
+    items[i].seq = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, &items[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK,
+                    ll_list_sort_parallel(&list, sort_item_cmp, NULL, 2));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, sorted_stable(list.head, N));
+}
+
+void test_ll_list_radix_sort(void) {
+  struct sort_item items[100];
+  unsigned int shift = 40;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_radix_sort(NULL, sort_item_key, &shift));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_radix_sort(&list, NULL, &shift));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_radix_sort(&list, sort_item_key, &shift));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  srand(24);
+  for (size_t i = 0; i < 100; i++) {
+    items[i].key = rand() % 1000;
+    items[i].seq = i;
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, &items[i]));
+  }
+  items[37].key = 1000;
+  ll_list_get(&list, 50);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_radix_sort(&list, sort_item_key, &shift));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, sorted_stable(list.head, 100));
+  TEST_ASSERT_EQUAL_PTR(&items[37], list.tail->data);
+}
+
+void test_ll_list_merge(void) {
+  struct sort_item items[40];
+  void *ptrs[20];
+  struct ll_list src;
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+
+  ll_list_init(&src);
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge(NULL, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge(&list, NULL, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge(&list, &list, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge(&list, &src, NULL, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_merge(&list, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+
+  // src comes from a single block that list takes over
+  for (size_t i = 0; i < 40; i++) {
+    items[i].key = (int)(i % 20);
+    items[i].seq = i;
+  }
+  for (size_t i = 0; i < 20; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, &items[i]));
+    ptrs[i] = &items[20 + i];
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append_array(&src, ptrs, 20));
+  ll_list_get(&list, 10);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_merge(&list, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, list_consistent(&src));
+  TEST_ASSERT_EQUAL(40, list.length);
+  TEST_ASSERT_EQUAL(0, src.length);
+  TEST_ASSERT_EQUAL(1, sorted_stable(list.head, 40));
+  TEST_ASSERT_EQUAL_PTR(&items[39], list.tail->data);
+  TEST_ASSERT_EQUAL_PTR(&items[1], ll_list_get(&list, 2));
+  TEST_ASSERT_EQUAL_PTR(NULL, src.blocks);
+
+  // Different allocators cannot share nodes
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&src, &counting));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&src, &items[0]));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge(&list, &src, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&src));
+}
+
+void test_ll_list_merge_k(void) {
+  enum { K = 5, LEN = 10 };
+  struct sort_item items[K * LEN];
+  struct ll_list lists[K];
+  struct alloc_counts counts = {0, 0};
+  struct ll_allocator counting = {counting_alloc, counting_free, &counts, NULL};
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge_k(NULL, 1, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge_k(&list, 1, NULL, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_merge_k(&list, 1, sort_item_cmp, NULL));
+
+  // Each list is one block
+  srand(27);
+  for (size_t l = 0; l < K; l++) {
+    void *ptrs[LEN];
+    int key = 0;
+    for (size_t i = 0; i < LEN; i++) {
+      key += rand() % 3;
+      items[l * LEN + i].key = key;
+      items[l * LEN + i].seq = l * LEN + i;
+      ptrs[i] = &items[l * LEN + i];
+    }
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_from_array(&lists[l], ptrs, LEN));
+  }
+
+  // A list with another allocator fails the whole merge
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, &counting));
+  struct ll_list saved = lists[K - 1];
+  lists[K - 1] = list;
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_list_merge_k(lists, K, sort_item_cmp, NULL));
+  lists[K - 1] = saved;
+  for (size_t l = 0; l < K; l++) {
+    TEST_ASSERT_EQUAL(LEN, lists[l].length);
+  }
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_merge_k(lists, K, sort_item_cmp, NULL));
+  TEST_ASSERT_EQUAL(K * LEN, lists[0].length);
+  TEST_ASSERT_EQUAL(1, sorted_stable(lists[0].head, K * LEN));
+  TEST_ASSERT_EQUAL(1, list_consistent(&lists[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&lists[0]));
+
+  // The emptied lists hold no memory
+  for (size_t l = 1; l < K; l++) {
+    TEST_ASSERT_EQUAL(1, list_consistent(&lists[l]));
+    TEST_ASSERT_EQUAL_PTR(NULL, lists[l].blocks);
+  }
+}
+
+void test_ll_cursor_init(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_init(NULL, &list));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_init(&cur, NULL));
+
+  // Cursor on an empty list is past the end
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL_PTR(NULL, cur.node);
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_cursor_get(&cur));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL(0, cur.idx);
+  TEST_ASSERT_EQUAL_PTR(list.head, cur.node);
+}
+
+void test_ll_cursor_next(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_next(NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  for (unsigned int i = 0; i < NUM_STRS - 1; i++) {
+    TEST_ASSERT_EQUAL_STRING(strs[i], ll_cursor_get(&cur));
+    TEST_ASSERT_EQUAL(LL_OK, ll_cursor_next(&cur));
+    TEST_ASSERT_EQUAL(i + 1, cur.idx);
+  }
+  TEST_ASSERT_EQUAL_STRING(strs[NUM_STRS - 1], ll_cursor_get(&cur));
+
+  // Step past the end, then stay there
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_next(&cur));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_cursor_get(&cur));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_next(&cur));
+}
+
+void test_ll_cursor_seek(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_seek(NULL, 0));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_seek(&cur, 0));  // Empty list
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+
+  // Forward, backward, to the tail
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 2));
+  TEST_ASSERT_EQUAL_STRING(strs[2], ll_cursor_get(&cur));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 1));
+  TEST_ASSERT_EQUAL_STRING(strs[1], ll_cursor_get(&cur));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 3));
+  TEST_ASSERT_EQUAL_PTR(list.tail, cur.node);
+
+  // Out of range leaves the cursor alone
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_seek(&cur, NUM_STRS));
+  TEST_ASSERT_EQUAL(3, cur.idx);
+
+  // Seek from past the end
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_next(&cur));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 1));
+  TEST_ASSERT_EQUAL_STRING(strs[1], ll_cursor_get(&cur));
+
+  // Seeking forward does not go back to the head. Break the link from the
+  // head to prove it.
+  struct ll_node *second = list.head->next;
+  list.head->next = NULL;
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 2));
+  TEST_ASSERT_EQUAL_STRING(strs[2], ll_cursor_get(&cur));
+  list.head->next = second;
+}
+
+void test_ll_cursor_get(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_cursor_get(NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL_PTR(strs[0], ll_cursor_get(&cur));
+}
+
+void test_ll_cursor_set(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_set(NULL, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_set(&cur, NULL));  // Past the end
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, NULL));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_cursor_set(&cur, (void *)strs[i]));
+    ll_cursor_next(&cur);
+  }
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_cursor_insert_after(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_insert_after(NULL, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_insert_after(&cur, NULL));
+
+  // Build the list by inserting behind a cursor that follows the tail
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_insert_after(&cur, (void *)strs[2]));
+  TEST_ASSERT_EQUAL(0, cur.idx);
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_insert_after(&cur, (void *)strs[1]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 2));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_insert_after(&cur, (void *)strs[3]));
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+}
+
+void test_ll_cursor_delete_next(void) {
+  struct ll_cursor cur;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_delete_next(NULL));
+
+  for (unsigned int i = 0; i < NUM_STRS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_init(&cur, &list));
+  TEST_ASSERT_EQUAL_PTR(strs[3], ll_list_get(&list, 3));  // Finger on the tail
+
+  // Delete the middle, then the tail
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_delete_next(&cur));
+  exp_list[0].next = &exp_list[2];
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_seek(&cur, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_cursor_delete_next(&cur));
+  exp_list[2].next = NULL;
+  TEST_ASSERT_EQUAL(1, list_consistent(&list));
+  TEST_ASSERT_EQUAL(1, lists_equal(&exp_list[0], list.head, strs_equal));
+
+  // Nothing after the tail
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_cursor_delete_next(&cur));
+}
+
 // Miscellaneous tests designed to test (non-exhaustively) list operations done
 // sequentially in case there are any odd side effects from one function
 // to another.
@@ -511,6 +2533,8 @@ int main(void) {
   RUN_TEST(test_ll_get);
   RUN_TEST(test_ll_length);
   RUN_TEST(test_ll_iterate);
+  RUN_TEST(test_ll_to_array);
+  RUN_TEST(test_ll_to_array_alloc);
 
   RUN_TEST(test_ll_append);
   RUN_TEST(test_ll_prepend);
@@ -519,6 +2543,76 @@ int main(void) {
   RUN_TEST(test_ll_delete);
   RUN_TEST(test_ll_destroy);
 
+  RUN_TEST(test_ll_set_sz);
+  RUN_TEST(test_ll_insert_after_sz);
+  RUN_TEST(test_ll_delete_sz);
+  RUN_TEST(test_ll_remove_if);
+  RUN_TEST(test_ll_move_if);
+  RUN_TEST(test_ll_get_sz);
+  RUN_TEST(test_ll_length_sz);
+
+  RUN_TEST(test_ll_append_new);
+  RUN_TEST(test_ll_prepend_new);
+  RUN_TEST(test_ll_insert_after_new);
+  RUN_TEST(test_ll_insert_after_node);
+  RUN_TEST(test_ll_insert_batch);
+  RUN_TEST(test_ll_delete_after_node);
+  RUN_TEST(test_ll_append_array);
+  RUN_TEST(test_ll_from_array);
+  RUN_TEST(test_ll_concat);
+  RUN_TEST(test_ll_splice);
+  RUN_TEST(test_ll_split);
+  RUN_TEST(test_ll_split_n);
+  RUN_TEST(test_ll_reverse);
+  RUN_TEST(test_ll_reverse_range);
+  RUN_TEST(test_ll_sort);
+  RUN_TEST(test_ll_sort_parallel);
+  RUN_TEST(test_ll_radix_sort);
+  RUN_TEST(test_ll_merge);
+  RUN_TEST(test_ll_merge_k);
+
+  RUN_TEST(test_ll_list_append);
+  RUN_TEST(test_ll_list_prepend);
+  RUN_TEST(test_ll_list_insert_after);
+  RUN_TEST(test_ll_list_delete);
+  RUN_TEST(test_ll_list_destroy);
+  RUN_TEST(test_ll_list_length);
+  RUN_TEST(test_ll_list_init_with_allocator);
+  RUN_TEST(test_ll_list_set);
+  RUN_TEST(test_ll_list_get);
+  RUN_TEST(test_ll_list_finger);
+  RUN_TEST(test_ll_list_append_new);
+  RUN_TEST(test_ll_list_insert_after_node);
+  RUN_TEST(test_ll_list_insert_batch);
+  RUN_TEST(test_ll_list_delete_after_node);
+  RUN_TEST(test_ll_list_remove_if);
+  RUN_TEST(test_ll_list_move_if);
+  RUN_TEST(test_ll_list_append_array);
+  RUN_TEST(test_ll_list_append_array_fallback);
+  RUN_TEST(test_ll_list_append_array_many);
+  RUN_TEST(test_ll_list_from_array);
+  RUN_TEST(test_ll_list_to_array_alloc);
+  RUN_TEST(test_ll_list_concat);
+  RUN_TEST(test_ll_list_splice);
+  RUN_TEST(test_ll_list_splice_blocks);
+  RUN_TEST(test_ll_list_split);
+  RUN_TEST(test_ll_list_split_n);
+  RUN_TEST(test_ll_list_reverse);
+  RUN_TEST(test_ll_list_reverse_range);
+  RUN_TEST(test_ll_list_sort);
+  RUN_TEST(test_ll_list_sort_parallel);
+  RUN_TEST(test_ll_list_radix_sort);
+  RUN_TEST(test_ll_list_merge);
+  RUN_TEST(test_ll_list_merge_k);
+
+  RUN_TEST(test_ll_cursor_init);
+  RUN_TEST(test_ll_cursor_next);
+  RUN_TEST(test_ll_cursor_seek);
+  RUN_TEST(test_ll_cursor_get);
+  RUN_TEST(test_ll_cursor_set);
+  RUN_TEST(test_ll_cursor_insert_after);
+  RUN_TEST(test_ll_cursor_delete_next);
+
   RUN_TEST(test_misc);
 
   return UNITY_END();
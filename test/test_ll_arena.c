@@ -0,0 +1,135 @@
+#include <stdint.h>
+
+#include "linked_list.h"
+#include "ll_arena.h"
+#include "unity.h"
+
+// Region size used by the arena under test. Fits exactly four list nodes so
+// that tests cross region boundaries.
+#define REGION_SIZE (4 * sizeof(struct ll_node))
+
+const char *strs[] = {"Red", "Green", "Blue", "Violet"};
+
+struct ll_arena arena;
+
+void setUp(void) { ll_arena_init(&arena, REGION_SIZE); }
+
+void tearDown(void) { ll_arena_destroy(&arena); }
+
+/**
+ * Helper test function. Count regions the arena currently holds.
+ */
+unsigned int num_regions(struct ll_arena *a) {
+  unsigned int n = 0;
+  struct ll_arena_region *r = a->regions;
+  while (r != NULL) {
+    n++;
+    r = r->next;
+  }
+  return n;
+}
+
+void test_ll_arena_init(void) {
+  struct ll_arena a;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_arena_init(NULL, REGION_SIZE));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_arena_init(&a, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_arena_init(&a, SIZE_MAX));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_arena_init(&a, REGION_SIZE));
+  TEST_ASSERT_EQUAL(0, num_regions(&a));
+}
+
+void test_ll_arena_alloc(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_arena_alloc(NULL, 1));
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_arena_alloc(&arena, SIZE_MAX));
+
+  // Allocations are bumped back to back and pointer aligned
+  unsigned char *a = ll_arena_alloc(&arena, 1);
+  unsigned char *b = ll_arena_alloc(&arena, sizeof(void *));
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_EQUAL_PTR(a + sizeof(void *), b);
+  TEST_ASSERT_EQUAL(1, num_regions(&arena));
+
+  // A full region makes the arena grow
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, REGION_SIZE));
+  TEST_ASSERT_EQUAL(2, num_regions(&arena));
+
+  // Oversized allocations get their own region
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, 3 * REGION_SIZE));
+  TEST_ASSERT_EQUAL(3, num_regions(&arena));
+}
+
+void test_ll_arena_reset(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_arena_reset(NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ll_arena_reset(&arena));  // Nothing allocated yet
+
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, REGION_SIZE));
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, REGION_SIZE));
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, REGION_SIZE));
+  TEST_ASSERT_EQUAL(3, num_regions(&arena));
+
+  // Only the newest region is kept, and it is reused from its start
+  TEST_ASSERT_EQUAL(LL_OK, ll_arena_reset(&arena));
+  TEST_ASSERT_EQUAL(1, num_regions(&arena));
+  void *again = ll_arena_alloc(&arena, REGION_SIZE);
+  TEST_ASSERT_EQUAL_PTR(arena.regions + 1, again);
+  TEST_ASSERT_EQUAL(1, num_regions(&arena));
+}
+
+void test_ll_arena_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_arena_destroy(NULL));
+
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, REGION_SIZE));
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, REGION_SIZE));
+  TEST_ASSERT_EQUAL(LL_OK, ll_arena_destroy(&arena));
+  TEST_ASSERT_EQUAL(0, num_regions(&arena));
+
+  // Arena is usable after destroy. Two destroys in a row are fine.
+  TEST_ASSERT_NOT_NULL(ll_arena_alloc(&arena, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_arena_destroy(&arena));
+  TEST_ASSERT_EQUAL(LL_OK, ll_arena_destroy(&arena));
+}
+
+void test_ll_arena_allocator(void) {
+  struct ll_list list;
+
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_arena_allocator(NULL));
+
+  const struct ll_allocator *a = ll_arena_allocator(&arena);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, a));
+  for (unsigned int i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i % 4]));
+  }
+  TEST_ASSERT_EQUAL(3, num_regions(&arena));
+
+  // Delete only unlinks
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 8));
+  TEST_ASSERT_EQUAL(8, ll_list_length(&list));
+  TEST_ASSERT_EQUAL_STRING(strs[2], ll_get(list.head, 1));
+  TEST_ASSERT_EQUAL(3, num_regions(&arena));
+
+  // Destroy resets the arena in one go
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+  TEST_ASSERT_EQUAL_PTR(NULL, list.head);
+  TEST_ASSERT_EQUAL(0, ll_list_length(&list));
+  TEST_ASSERT_EQUAL(1, num_regions(&arena));
+
+  // The list can be rebuilt from the recycled region
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL_PTR(arena.regions + 1, list.head);
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_ll_arena_init);
+  RUN_TEST(test_ll_arena_alloc);
+  RUN_TEST(test_ll_arena_reset);
+  RUN_TEST(test_ll_arena_destroy);
+  RUN_TEST(test_ll_arena_allocator);
+
+  return UNITY_END();
+}
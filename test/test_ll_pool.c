@@ -0,0 +1,141 @@
+#include <stdint.h>
+
+#include "linked_list.h"
+#include "ll_pool.h"
+#include "unity.h"
+
+// Number of blocks per chunk used by the pool under test. Kept small so that
+// tests cross chunk boundaries.
+#define CHUNK_BLOCKS (4)
+
+const char *strs[] = {"Red", "Green", "Blue", "Violet"};
+
+struct ll_pool pool;
+
+void setUp(void) { ll_pool_init(&pool, 0, CHUNK_BLOCKS); }
+
+void tearDown(void) { ll_pool_destroy(&pool); }
+
+/**
+ * Helper test function. Count chunks the pool has allocated so far.
+ */
+unsigned int num_chunks(struct ll_pool *p) {
+  unsigned int n = 0;
+  struct ll_pool_chunk *c = p->chunks;
+  while (c != NULL) {
+    n++;
+    c = c->next;
+  }
+  return n;
+}
+
+void test_ll_pool_init(void) {
+  struct ll_pool p;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_pool_init(NULL, 0, CHUNK_BLOCKS));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_pool_init(&p, 0, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_pool_init(&p, 64, SIZE_MAX / 2));
+
+  // Default block size fits a node. Nothing is allocated up front.
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_init(&p, 0, CHUNK_BLOCKS));
+  TEST_ASSERT_EQUAL(sizeof(struct ll_node), p.block_size);
+  TEST_ASSERT_EQUAL(0, num_chunks(&p));
+
+  // Tiny blocks are grown to hold the free list link and rounded up to
+  // pointer alignment
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_init(&p, 1, CHUNK_BLOCKS));
+  TEST_ASSERT_EQUAL(sizeof(void *), p.block_size);
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_init(&p, sizeof(void *) + 1, CHUNK_BLOCKS));
+  TEST_ASSERT_EQUAL(2 * sizeof(void *), p.block_size);
+}
+
+void test_ll_pool_alloc(void) {
+  void *blocks[CHUNK_BLOCKS + 1];
+
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_pool_alloc(NULL));
+
+  // Blocks of one chunk are handed out back to back
+  for (unsigned int i = 0; i < CHUNK_BLOCKS; i++) {
+    blocks[i] = ll_pool_alloc(&pool);
+    TEST_ASSERT_NOT_NULL(blocks[i]);
+    if (i > 0) {
+      TEST_ASSERT_EQUAL_PTR((unsigned char *)blocks[i - 1] + pool.block_size,
+                            blocks[i]);
+    }
+  }
+  TEST_ASSERT_EQUAL(1, num_chunks(&pool));
+
+  // Running out of blocks grows the pool by a chunk
+  blocks[CHUNK_BLOCKS] = ll_pool_alloc(&pool);
+  TEST_ASSERT_NOT_NULL(blocks[CHUNK_BLOCKS]);
+  TEST_ASSERT_EQUAL(2, num_chunks(&pool));
+}
+
+void test_ll_pool_free(void) {
+  ll_pool_free(NULL, NULL);   // Should not crash
+  ll_pool_free(&pool, NULL);  // Should not crash
+
+  void *a = ll_pool_alloc(&pool);
+  void *b = ll_pool_alloc(&pool);
+
+  // Freed blocks are reused most recently freed first
+  ll_pool_free(&pool, a);
+  ll_pool_free(&pool, b);
+  TEST_ASSERT_EQUAL_PTR(b, ll_pool_alloc(&pool));
+  TEST_ASSERT_EQUAL_PTR(a, ll_pool_alloc(&pool));
+  TEST_ASSERT_EQUAL(1, num_chunks(&pool));
+}
+
+void test_ll_pool_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ll_pool_destroy(NULL));
+
+  for (unsigned int i = 0; i < 3 * CHUNK_BLOCKS; i++) {
+    TEST_ASSERT_NOT_NULL(ll_pool_alloc(&pool));
+  }
+  TEST_ASSERT_EQUAL(3, num_chunks(&pool));
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_destroy(&pool));
+  TEST_ASSERT_EQUAL(0, num_chunks(&pool));
+
+  // Pool is usable after destroy. Two destroys in a row are fine.
+  TEST_ASSERT_NOT_NULL(ll_pool_alloc(&pool));
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_destroy(&pool));
+  TEST_ASSERT_EQUAL(LL_OK, ll_pool_destroy(&pool));
+}
+
+void test_ll_pool_allocator(void) {
+  struct ll_list list;
+
+  TEST_ASSERT_EQUAL_PTR(NULL, ll_pool_allocator(NULL));
+
+  // Oversized requests are refused
+  const struct ll_allocator *a = ll_pool_allocator(&pool);
+  TEST_ASSERT_EQUAL_PTR(NULL, a->alloc(a->ctx, pool.block_size + 1));
+
+  // Churn on a list backed by the pool stays within the first chunk because
+  // deleted nodes are recycled
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_init_with_allocator(&list, a));
+  for (unsigned int i = 0; i < 100; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[i % 4]));
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[(i + 1) % 4]));
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 0));
+    TEST_ASSERT_EQUAL(LL_OK, ll_list_delete(&list, 0));
+  }
+  TEST_ASSERT_EQUAL(1, num_chunks(&pool));
+
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[0]));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_append(&list, (void *)strs[1]));
+  TEST_ASSERT_EQUAL_STRING(strs[1], ll_get(list.head, 1));
+  TEST_ASSERT_EQUAL(LL_OK, ll_list_destroy(&list));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_ll_pool_init);
+  RUN_TEST(test_ll_pool_alloc);
+  RUN_TEST(test_ll_pool_free);
+  RUN_TEST(test_ll_pool_destroy);
+  RUN_TEST(test_ll_pool_allocator);
+
+  return UNITY_END();
+}
@@ -0,0 +1,253 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "skip_list.h"
+#include "unity.h"
+
+// Enough elements for the list to grow several levels
+#define NUM_ELEMS (200)
+
+struct sl_list list;
+
+void setUp(void) { sl_init(&list); }
+
+void tearDown(void) { sl_destroy(&list); }
+
+/**
+ * Helper test function. Turn a small integer into a data pointer.
+ */
+void *p(uintptr_t i) { return (void *)(i + 1); }
+
+/**
+ * Helper test function. Check the list against the expected data in @p exp and
+ * check that every link on every level has the right width.
+ */
+int list_is(struct sl_list *l, void **exp, size_t n) {
+  struct sl_node *nodes[4 * NUM_ELEMS];
+  size_t i = 0;
+
+  for (struct sl_node *node = l->head[0].next; node != NULL;
+       node = node->links[0].next) {
+    if (i >= n || node->data != exp[i]) {
+      return 0;
+    }
+    nodes[i++] = node;
+  }
+  if (i != n || l->length != n) {
+    return 0;
+  }
+
+  for (size_t lvl = 0; lvl < l->level; lvl++) {
+    struct sl_link *links = l->head;
+    size_t pos = 0;  // Position of links' node, head is 0
+    while (links[lvl].next != NULL) {
+      size_t next = pos + links[lvl].width;
+      if (next == 0 || next > n || nodes[next - 1] != links[lvl].next) {
+        return 0;
+      }
+      pos = next;
+      links = links[lvl].next->links;
+    }
+  }
+  for (size_t lvl = l->level; lvl < SL_MAX_LEVEL; lvl++) {
+    if (l->head[lvl].next != NULL) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+void test_sl_init(void) {
+  struct sl_list l;
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_init(NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_init_with_allocator(&l, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, sl_init(&l));
+  TEST_ASSERT_EQUAL(0, l.level);
+  TEST_ASSERT_EQUAL(1, list_is(&l, NULL, 0));
+}
+
+void test_sl_append(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_append(NULL, NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+  TEST_ASSERT_TRUE(list.level > 1);
+}
+
+void test_sl_prepend(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_prepend(NULL, NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[NUM_ELEMS - 1 - i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, sl_prepend(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_sl_set(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_set(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_set(&list, 0, NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, NULL));
+  }
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, sl_set(&list, i, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_set(&list, NUM_ELEMS, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_sl_insert_after(void) {
+  void *exp[] = {p(0), p(1), p(2), p(3)};
+
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_insert_after(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_insert_after(&list, 0, NULL));
+
+  TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, p(0)));
+  TEST_ASSERT_EQUAL(LL_OK, sl_insert_after(&list, 0, p(2)));
+  TEST_ASSERT_EQUAL(LL_OK, sl_insert_after(&list, 0, p(1)));
+  TEST_ASSERT_EQUAL(LL_OK, sl_insert_after(&list, 2, p(3)));
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_insert_after(&list, 4, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 4));
+}
+
+void test_sl_delete(void) {
+  void *exp[NUM_ELEMS];
+  size_t n = NUM_ELEMS;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_delete(NULL, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_delete(&list, 0));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_delete(&list, NUM_ELEMS));
+
+  while (n > 0) {
+    size_t idx = n / 3;
+    TEST_ASSERT_EQUAL(LL_OK, sl_delete(&list, idx));
+    n--;
+    for (size_t i = idx; i < n; i++) {
+      exp[i] = exp[i + 1];
+    }
+    TEST_ASSERT_EQUAL(1, list_is(&list, exp, n));
+  }
+  TEST_ASSERT_EQUAL(0, list.level);
+}
+
+void test_sl_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, sl_destroy(NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, sl_destroy(&list));
+  TEST_ASSERT_EQUAL(1, list_is(&list, NULL, 0));
+  TEST_ASSERT_EQUAL(LL_OK, sl_destroy(&list));
+}
+
+void test_sl_get(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, sl_get(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, sl_get(&list, 0));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, p(i)));
+  }
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL_PTR(p(i), sl_get(&list, i));
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, sl_get(&list, NUM_ELEMS));
+}
+
+void test_sl_length(void) {
+  TEST_ASSERT_EQUAL(0, sl_length(NULL));
+  TEST_ASSERT_EQUAL(0, sl_length(&list));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, sl_prepend(&list, p(i)));
+    TEST_ASSERT_EQUAL(i + 1, sl_length(&list));
+  }
+}
+
+/*
+ * Iterator callback that counts nodes and stops at the third one.
+ */
+enum ll_status count_until_3(struct sl_node *node, void *cookie) {
+  (*(size_t *)cookie)++;
+  return node->data == p(2) ? LL_FAIL : LL_OK;
+}
+
+void test_sl_iterate(void) {
+  size_t cnt = 0;
+
+  sl_iterate(NULL, count_until_3, &cnt);
+  sl_iterate(&list, count_until_3, &cnt);
+  TEST_ASSERT_EQUAL(0, cnt);
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, sl_append(&list, p(i)));
+  }
+  sl_iterate(&list, count_until_3, &cnt);
+  TEST_ASSERT_EQUAL(3, cnt);
+}
+
+// Random inserts and deletes checked against a plain array
+void test_sl_random(void) {
+  void *exp[4 * NUM_ELEMS];
+  size_t n = 0;
+
+  srand(2);
+  for (unsigned int round = 0; round < 3000; round++) {
+    int op = rand() % 3;
+    if (n == 0 || (op < 2 && n < 4 * NUM_ELEMS)) {
+      void *d = p(round);
+      if (n == 0 || op == 0) {
+        TEST_ASSERT_EQUAL(LL_OK, sl_prepend(&list, d));
+        for (size_t i = n; i > 0; i--) {
+          exp[i] = exp[i - 1];
+        }
+        exp[0] = d;
+      } else {
+        size_t idx = (size_t)rand() % n;
+        TEST_ASSERT_EQUAL(LL_OK, sl_insert_after(&list, idx, d));
+        for (size_t i = n; i > idx + 1; i--) {
+          exp[i] = exp[i - 1];
+        }
+        exp[idx + 1] = d;
+      }
+      n++;
+    } else {
+      size_t idx = (size_t)rand() % n;
+      TEST_ASSERT_EQUAL(LL_OK, sl_delete(&list, idx));
+      n--;
+      for (size_t i = idx; i < n; i++) {
+        exp[i] = exp[i + 1];
+      }
+    }
+    TEST_ASSERT_EQUAL(1, list_is(&list, exp, n));
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_sl_init);
+  RUN_TEST(test_sl_get);
+  RUN_TEST(test_sl_length);
+  RUN_TEST(test_sl_iterate);
+
+  RUN_TEST(test_sl_append);
+  RUN_TEST(test_sl_prepend);
+  RUN_TEST(test_sl_set);
+  RUN_TEST(test_sl_insert_after);
+  RUN_TEST(test_sl_delete);
+  RUN_TEST(test_sl_destroy);
+
+  RUN_TEST(test_sl_random);
+
+  return UNITY_END();
+}
@@ -0,0 +1,249 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tree_list.h"
+#include "unity.h"
+
+// Enough elements for the tree to need rotations of every kind
+#define NUM_ELEMS (200)
+
+struct tl_list list;
+
+void setUp(void) { tl_init(&list); }
+
+void tearDown(void) { tl_destroy(&list); }
+
+/**
+ * Helper test function. Turn a small integer into a data pointer.
+ */
+void *p(uintptr_t i) { return (void *)(i + 1); }
+
+/**
+ * Helper test function. Check AVL balance, sizes and heights of the subtree
+ * @p n and that its in-order data matches @p exp starting at @p *i.
+ *
+ * @return height of the subtree, or -1 if anything is wrong.
+ */
+int check(struct tl_node *n, void **exp, size_t *i, size_t max) {
+  if (n == NULL) {
+    return 0;
+  }
+  int hl = check(n->left, exp, i, max);
+  if (hl < 0 || *i >= max || n->data != exp[*i]) {
+    return -1;
+  }
+  (*i)++;
+  int hr = check(n->right, exp, i, max);
+  if (hr < 0 || hl - hr > 1 || hr - hl > 1) {
+    return -1;
+  }
+  size_t sz = 1 + (n->left ? n->left->size : 0) +
+              (n->right ? n->right->size : 0);
+  int h = (hl > hr ? hl : hr) + 1;
+  if (n->size != sz || n->height != h) {
+    return -1;
+  }
+  return h;
+}
+
+int list_is(struct tl_list *l, void **exp, size_t n) {
+  size_t i = 0;
+  return check(l->root, exp, &i, n) >= 0 && i == n && tl_length(l) == n;
+}
+
+void test_tl_init(void) {
+  struct tl_list l;
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_init(NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_init_with_allocator(&l, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, tl_init(&l));
+  TEST_ASSERT_EQUAL(1, list_is(&l, NULL, 0));
+}
+
+void test_tl_append(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_append(NULL, NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_tl_prepend(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_prepend(NULL, NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[NUM_ELEMS - 1 - i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, tl_prepend(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_tl_set(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_set(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_set(&list, 0, NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, NULL));
+  }
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, tl_set(&list, i, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_set(&list, NUM_ELEMS, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_tl_insert_after(void) {
+  void *exp[] = {p(0), p(1), p(2), p(3)};
+
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_insert_after(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_insert_after(&list, 0, NULL));
+
+  TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, p(0)));
+  TEST_ASSERT_EQUAL(LL_OK, tl_insert_after(&list, 0, p(2)));
+  TEST_ASSERT_EQUAL(LL_OK, tl_insert_after(&list, 0, p(1)));
+  TEST_ASSERT_EQUAL(LL_OK, tl_insert_after(&list, 2, p(3)));
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_insert_after(&list, 4, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, 4));
+}
+
+void test_tl_delete(void) {
+  void *exp[NUM_ELEMS];
+  size_t n = NUM_ELEMS;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_delete(NULL, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_delete(&list, 0));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_delete(&list, NUM_ELEMS));
+
+  while (n > 0) {
+    size_t idx = n / 3;
+    TEST_ASSERT_EQUAL(LL_OK, tl_delete(&list, idx));
+    n--;
+    for (size_t i = idx; i < n; i++) {
+      exp[i] = exp[i + 1];
+    }
+    TEST_ASSERT_EQUAL(1, list_is(&list, exp, n));
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, list.root);
+}
+
+void test_tl_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, tl_destroy(NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, tl_destroy(&list));
+  TEST_ASSERT_EQUAL(1, list_is(&list, NULL, 0));
+  TEST_ASSERT_EQUAL(LL_OK, tl_destroy(&list));
+}
+
+void test_tl_get(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, tl_get(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, tl_get(&list, 0));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, p(i)));
+  }
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL_PTR(p(i), tl_get(&list, i));
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, tl_get(&list, NUM_ELEMS));
+}
+
+void test_tl_length(void) {
+  TEST_ASSERT_EQUAL(0, tl_length(NULL));
+  TEST_ASSERT_EQUAL(0, tl_length(&list));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, tl_prepend(&list, p(i)));
+    TEST_ASSERT_EQUAL(i + 1, tl_length(&list));
+  }
+}
+
+/*
+ * Iterator callback that checks nodes come in order and stops at the 100th.
+ */
+enum ll_status in_order_until_100(struct tl_node *node, void *cookie) {
+  size_t *cnt = cookie;
+  if (node->data != p(*cnt)) {
+    return LL_FAIL;
+  }
+  (*cnt)++;
+  return *cnt == 100 ? LL_FAIL : LL_OK;
+}
+
+void test_tl_iterate(void) {
+  size_t cnt = 0;
+
+  tl_iterate(NULL, in_order_until_100, &cnt);
+  tl_iterate(&list, in_order_until_100, &cnt);
+  TEST_ASSERT_EQUAL(0, cnt);
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, tl_append(&list, p(i)));
+  }
+  tl_iterate(&list, in_order_until_100, &cnt);
+  TEST_ASSERT_EQUAL(100, cnt);
+}
+
+// Random inserts and deletes checked against a plain array
+void test_tl_random(void) {
+  void *exp[4 * NUM_ELEMS];
+  size_t n = 0;
+
+  srand(3);
+  for (unsigned int round = 0; round < 3000; round++) {
+    int op = rand() % 3;
+    if (n == 0 || (op < 2 && n < 4 * NUM_ELEMS)) {
+      void *d = p(round);
+      if (n == 0 || op == 0) {
+        TEST_ASSERT_EQUAL(LL_OK, tl_prepend(&list, d));
+        for (size_t i = n; i > 0; i--) {
+          exp[i] = exp[i - 1];
+        }
+        exp[0] = d;
+      } else {
+        size_t idx = (size_t)rand() % n;
+        TEST_ASSERT_EQUAL(LL_OK, tl_insert_after(&list, idx, d));
+        for (size_t i = n; i > idx + 1; i--) {
+          exp[i] = exp[i - 1];
+        }
+        exp[idx + 1] = d;
+      }
+      n++;
+    } else {
+      size_t idx = (size_t)rand() % n;
+      TEST_ASSERT_EQUAL(LL_OK, tl_delete(&list, idx));
+      n--;
+      for (size_t i = idx; i < n; i++) {
+        exp[i] = exp[i + 1];
+      }
+    }
+    TEST_ASSERT_EQUAL(1, list_is(&list, exp, n));
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_tl_init);
+  RUN_TEST(test_tl_get);
+  RUN_TEST(test_tl_length);
+  RUN_TEST(test_tl_iterate);
+
+  RUN_TEST(test_tl_append);
+  RUN_TEST(test_tl_prepend);
+  RUN_TEST(test_tl_set);
+  RUN_TEST(test_tl_insert_after);
+  RUN_TEST(test_tl_delete);
+  RUN_TEST(test_tl_destroy);
+
+  RUN_TEST(test_tl_random);
+
+  return UNITY_END();
+}
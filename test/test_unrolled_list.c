@@ -0,0 +1,262 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "unrolled_list.h"
+#include "unity.h"
+
+// Enough elements to fill several nodes
+#define NUM_ELEMS (5 * ULL_NODE_CAPACITY)
+
+struct ull_list list;
+
+void setUp(void) { ull_init(&list); }
+
+void tearDown(void) { ull_destroy(&list); }
+
+/**
+ * Helper test function. Turn a small integer into a data pointer.
+ */
+void *p(uintptr_t i) { return (void *)(i + 1); }
+
+/**
+ * Helper test function. Check the list against the expected data in @p exp and
+ * check the node invariants: no empty nodes, tail is the last node, length is
+ * the sum of the node counts.
+ */
+int list_is(struct ull_list *l, void **exp, size_t n) {
+  size_t i = 0;
+  struct ull_node *tail = NULL;
+  for (struct ull_node *node = l->head; node != NULL; node = node->next) {
+    if (node->count == 0 || node->count > ULL_NODE_CAPACITY) {
+      return 0;
+    }
+    for (size_t j = 0; j < node->count; j++, i++) {
+      if (i >= n || node->data[j] != exp[i]) {
+        return 0;
+      }
+    }
+    tail = node;
+  }
+  return i == n && l->tail == tail && l->length == n;
+}
+
+/**
+ * Helper test function. Count nodes in the list.
+ */
+size_t num_nodes(struct ull_list *l) {
+  size_t n = 0;
+  for (struct ull_node *node = l->head; node != NULL; node = node->next) {
+    n++;
+  }
+  return n;
+}
+
+void test_ull_init(void) {
+  struct ull_list l;
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_init(NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_init_with_allocator(&l, NULL));
+  TEST_ASSERT_EQUAL(LL_OK, ull_init(&l));
+  TEST_ASSERT_EQUAL(1, list_is(&l, NULL, 0));
+}
+
+void test_ull_append(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_append(NULL, NULL));
+
+  // Appending keeps nodes full
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, ull_append(&list, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+  TEST_ASSERT_EQUAL(NUM_ELEMS / ULL_NODE_CAPACITY, num_nodes(&list));
+}
+
+void test_ull_prepend(void) {
+  void *exp[NUM_ELEMS];
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_prepend(NULL, NULL));
+
+  // Prepending into a full head splits it
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[NUM_ELEMS - 1 - i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, ull_prepend(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_ull_set(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_set(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_set(&list, 0, NULL));
+
+  void *exp[NUM_ELEMS];
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ull_append(&list, NULL));
+  }
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, ull_set(&list, i, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_set(&list, NUM_ELEMS, NULL));
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, NUM_ELEMS));
+}
+
+void test_ull_insert_after(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_insert_after(NULL, 0, NULL));
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_insert_after(&list, 0, NULL));
+
+  // Fill one node, then insert into the middle of it to force a split
+  void *exp[ULL_NODE_CAPACITY + 1];
+  for (uintptr_t i = 0; i < ULL_NODE_CAPACITY; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ull_append(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ull_insert_after(&list, 2, p(100)));
+  for (uintptr_t i = 0, j = 0; i < ULL_NODE_CAPACITY + 1; i++) {
+    exp[i] = i == 3 ? p(100) : p(j++);
+  }
+  TEST_ASSERT_EQUAL(1, list_is(&list, exp, ULL_NODE_CAPACITY + 1));
+  TEST_ASSERT_EQUAL(2, num_nodes(&list));
+
+  // Insert after the tail and past the end
+  TEST_ASSERT_EQUAL(LL_OK,
+                    ull_insert_after(&list, ULL_NODE_CAPACITY, p(200)));
+  TEST_ASSERT_EQUAL_PTR(p(200), ull_get(&list, ULL_NODE_CAPACITY + 1));
+  TEST_ASSERT_EQUAL(LL_FAIL,
+                    ull_insert_after(&list, ULL_NODE_CAPACITY + 2, NULL));
+}
+
+void test_ull_delete(void) {
+  void *exp[NUM_ELEMS];
+  size_t n = NUM_ELEMS;
+
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_delete(NULL, 0));
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_delete(&list, 0));
+
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    exp[i] = p(i);
+    TEST_ASSERT_EQUAL(LL_OK, ull_append(&list, exp[i]));
+  }
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_delete(&list, NUM_ELEMS));
+
+  // Keep deleting from the middle so that nodes merge and borrow
+  while (n > 0) {
+    size_t idx = n / 2;
+    TEST_ASSERT_EQUAL(LL_OK, ull_delete(&list, idx));
+    n--;
+    for (size_t i = idx; i < n; i++) {
+      exp[i] = exp[i + 1];
+    }
+    TEST_ASSERT_EQUAL(1, list_is(&list, exp, n));
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, list.head);
+}
+
+void test_ull_destroy(void) {
+  TEST_ASSERT_EQUAL(LL_FAIL, ull_destroy(NULL));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ull_append(&list, p(i)));
+  }
+  TEST_ASSERT_EQUAL(LL_OK, ull_destroy(&list));
+  TEST_ASSERT_EQUAL(1, list_is(&list, NULL, 0));
+  TEST_ASSERT_EQUAL(LL_OK, ull_destroy(&list));
+}
+
+void test_ull_get(void) {
+  TEST_ASSERT_EQUAL_PTR(NULL, ull_get(NULL, 0));
+  TEST_ASSERT_EQUAL_PTR(NULL, ull_get(&list, 0));
+
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ull_prepend(&list, p(NUM_ELEMS - 1 - i)));
+  }
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL_PTR(p(i), ull_get(&list, i));
+  }
+  TEST_ASSERT_EQUAL_PTR(NULL, ull_get(&list, NUM_ELEMS));
+}
+
+void test_ull_length(void) {
+  TEST_ASSERT_EQUAL(0, ull_length(NULL));
+  TEST_ASSERT_EQUAL(0, ull_length(&list));
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ull_prepend(&list, p(i)));
+    TEST_ASSERT_EQUAL(i + 1, ull_length(&list));
+  }
+}
+
+/*
+ * Iterator callback that counts elements and stops at the one past the first
+ * node.
+ */
+enum ll_status count_until(void *data, void *cookie) {
+  (*(size_t *)cookie)++;
+  return data == p(ULL_NODE_CAPACITY) ? LL_FAIL : LL_OK;
+}
+
+void test_ull_iterate(void) {
+  size_t cnt = 0;
+
+  ull_iterate(NULL, count_until, &cnt);
+  ull_iterate(&list, count_until, &cnt);
+  TEST_ASSERT_EQUAL(0, cnt);
+
+  for (uintptr_t i = 0; i < NUM_ELEMS; i++) {
+    TEST_ASSERT_EQUAL(LL_OK, ull_append(&list, p(i)));
+  }
+  ull_iterate(&list, count_until, &cnt);
+  TEST_ASSERT_EQUAL(ULL_NODE_CAPACITY + 1, cnt);
+}
+
+// Random inserts and deletes checked against a plain array
+void test_ull_random(void) {
+  void *exp[4 * NUM_ELEMS];
+  size_t n = 0;
+
+  srand(1);
+  for (unsigned int round = 0; round < 2000; round++) {
+    int op = rand() % 3;
+    if (n == 0 || (op < 2 && n < 4 * NUM_ELEMS)) {
+      size_t idx = n == 0 ? 0 : (size_t)rand() % n;
+      void *d = p(round);
+      if (n == 0) {
+        TEST_ASSERT_EQUAL(LL_OK, ull_prepend(&list, d));
+        exp[0] = d;
+      } else {
+        TEST_ASSERT_EQUAL(LL_OK, ull_insert_after(&list, idx, d));
+        for (size_t i = n; i > idx + 1; i--) {
+          exp[i] = exp[i - 1];
+        }
+        exp[idx + 1] = d;
+      }
+      n++;
+    } else {
+      size_t idx = (size_t)rand() % n;
+      TEST_ASSERT_EQUAL(LL_OK, ull_delete(&list, idx));
+      n--;
+      for (size_t i = idx; i < n; i++) {
+        exp[i] = exp[i + 1];
+      }
+    }
+    TEST_ASSERT_EQUAL(1, list_is(&list, exp, n));
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_ull_init);
+  RUN_TEST(test_ull_get);
+  RUN_TEST(test_ull_length);
+  RUN_TEST(test_ull_iterate);
+
+  RUN_TEST(test_ull_append);
+  RUN_TEST(test_ull_prepend);
+  RUN_TEST(test_ull_set);
+  RUN_TEST(test_ull_insert_after);
+  RUN_TEST(test_ull_delete);
+  RUN_TEST(test_ull_destroy);
+
+  RUN_TEST(test_ull_random);
+
+  return UNITY_END();
+}